@@ -2,7 +2,8 @@
 * ESP8266 SSID CONNECT FRAMEWORK
 *
 * SOFT AP DETAILS
-* SSID = ESP8266 | PASSWORD = 123456789
+* SSID = <PROJECT NAME>-<LAST 3 MAC BYTES> | PASSWORD = 12345678
+* CHANNEL = LEAST CONGESTED ONE (SCANNED BEFORE STARTING)
 *
 * SET THE WIFI RECONNECT INTERVAL TO ATLEAST
 * 4000ms (4 s), SO AS TO GIVE ENOUGH TIME TO
@@ -20,19 +21,15 @@
 *                    TO HARDCODED SSID           OR IN TCP WEBSERVER
 *                                              - WIFI CONNECT SUCCESSFULL
 *                                              - ON RESTART CHECK FOR VALID SSID CACHE. IF FOUND
-*                                                CONNECT USING THAT ELSE USE HARDCODED ONE
+*                                                TRY THAT FIRST, THEN THE HARDCODED ONE
 *
 *  INTERNAL          NOT ABLE TO CONNECT       - START SSID FRAMEWORK EITHER IN SMARTCONFIG
 *                    TO INTERNALLY CACHED        OR IN TCP WEBSERVER
 *                    SSID                      - WIFI CONNECT SUCCESSFULL
 *                                              - AUTO CONNECT ON RESTART FROM INTERNAL SSID CACHE
 *
-*  FLASH             NOT ABLE TO CONNECT       - START SSID FRAMEWORK EITHER IN SMARTCONFIG
-*  EEPROM            TO SSID READ FROM           OR IN TCP WEBSERVER
-*                    FLASH/EEPROM AT GIVEN     - WIFI CONNECT SUCCESSFULL
-*                    ADDRESS                   - SAVE WIFI CREDENTIAL TO FLASH/EEPROM
-*                                              - ON RESTART, AGAIN READ FLASH/EEPROM ADDRESS
-*                                                AND CONNECT TO READ SSID
+*  FLASH             NOT IMPLEMENTED. THE MODE VALUES ARE RESERVED AND SELECTING
+*  EEPROM            THEM IS REPORTED AND IGNORED
 *
 *
 *
@@ -59,34 +56,233 @@ static uint8_t _esp8266_ssid_framework_debug;
 //OPERATION RELATED
 static ESP8266_SSID_FRAMEWORK_SSID_INPUT_MODE _input_mode;
 static ESP8266_SSID_FRAMEWORK_CONFIG_MODE _config_mode;
-static ESP8266_SSID_FRAMEWORK_GPIO_TRIGGER _gpio_trigger_level;
 static volatile uint8_t _esp8266_ssid_framework_wifi_connected = 0;
+static ESP8266_SSID_FRAMEWORK_STATE _esp8266_ssid_framework_state = ESP8266_SSID_FRAMEWORK_STATE_IDLE;
 static uint8_t _led_gpio_pin;
 
 //TIMER RELATED
 os_timer_t _status_led_timer;
 os_timer_t _wifi_connect_timer;
+os_timer_t _supervisor_probe_timer;
+os_timer_t _supervisor_reconnect_timer;
+os_timer_t _ip_lease_verify_timer;
+os_timer_t _connected_user_cb_timer;
 
-//HTML DATA RELEATED
-static char* _config_page_html;
+//USER DATA RELATED
 char* _user_data_ptrs[ESP8266_SSID_FRAMEWORK_CUSTOM_FIELD_MAX_COUNT];
+static char _user_data_values[ESP8266_SSID_FRAMEWORK_CUSTOM_FIELD_MAX_COUNT][ESP8266_SSID_FRAMEWORK_CUSTOM_FIELD_VALUE_LEN];
 static ESP8266_SSID_FRAMEWORK_CONFIG_USER_FIELD_GROUP* _custom_user_field_group;
+static uint8_t _custom_field_offset[ESP8266_SSID_FRAMEWORK_CUSTOM_FIELD_MAX_COUNT];
+static uint32_t _custom_field_signature;
 static char* _project_name;
+static char _mdns_hostname[ESP8266_SSID_FRAMEWORK_MDNS_HOSTNAME_LEN];
 
 //SSID RELATED
+static uint8_t _ssid_candidates[ESP8266_SSID_FRAMEWORK_SSID_CANDIDATE_MAX_COUNT];
+static uint8_t _ssid_candidate_count;
+static uint8_t _ssid_candidate_index;
+static struct station_config* _ssid_supplied_config;
 static uint8_t _ssid_connect_retries;
 static uint8_t _ssid_connect_retry_count;
 static uint32_t _ssid_connect_retry_delay_ms;
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_INPUT_HARDCODED
 static ESP8266_SSID_FRAMEWORK_HARDCODED_SSID_DETAILS _ssid_hardcoded_name_pwd;
-static ESP8266_SSID_FRAMEWORK_FLASH_SSID_DETAILS _ssid_flash_name_pwd;
-static ESP8266_SSID_FRAMEWORK_EEPROM_SSID_DETAILS _ssid_eeprom_name_pwd;
+#endif
+#if ESP8266_SSID_FRAMEWORK_MODULE_INPUT_GPIO
 static uint8_t _ssid_gpio_trigger_pin;
+static ESP8266_SSID_FRAMEWORK_GPIO_TRIGGER _gpio_trigger_level;
+#endif
+
+//DISCONNECT REASON RELATED
+//SLOT 0 = UNKNOWN | SLOTS 1-24 = 802.11 REASONS 1-24 | SLOTS 25-29 = ESP REASONS 200-204
+static uint16_t _disconnect_reason_counts[ESP8266_SSID_FRAMEWORK_REASON_SLOT_COUNT];
+
+//SUPERVISOR RELATED
+static uint32_t _supervisor_probe_interval_ms = ESP8266_SSID_FRAMEWORK_PROBE_INTERVAL_MS;
+static uint32_t _supervisor_outage_budget_ms = ESP8266_SSID_FRAMEWORK_OUTAGE_BUDGET_MS;
+static uint32_t _supervisor_backoff_ms;
+static uint32_t _supervisor_outage_ms;
+static uint8_t _supervisor_probe_fails;
+static uint8_t _supervisor_gateway_replied;
+static struct ping_option _supervisor_ping_option;
+
+//IP RELATED
+static ESP8266_SSID_FRAMEWORK_PARAM_RECORD _param_record;
+static uint8_t _param_record_loaded;
+static uint16_t _param_sector;
+static uint8_t _ip_connect_mode;
+static uint8_t _ip_lease_verifying;
+static uint8_t _ip_lease_probes;
+static uint8_t _ip_lease_reused;
+static uint8_t _ip_timing;
+static uint32_t _ip_connect_start_us;
+static uint32_t _ip_time_to_ip_ms[ESP8266_SSID_FRAMEWORK_IP_MODE_COUNT];
 
 //CB FUNCTIONS
 static void (*_esp8266_ssid_framework_wifi_connected_user_cb)(char**);
+static void (*_esp8266_ssid_framework_link_up_user_cb)(void);
+static void (*_esp8266_ssid_framework_link_down_user_cb)(uint8_t);
+static uint8_t _esp8266_ssid_framework_wifi_connected_user_cb_done;
+
+//EVENT RELATED
+static ESP8266_SSID_FRAMEWORK_EVENT_LISTENER _event_listeners[ESP8266_SSID_FRAMEWORK_EVENT_LISTENER_MAX_COUNT];
+static ESP8266_SSID_FRAMEWORK_EVENT _event_queue[ESP8266_SSID_FRAMEWORK_EVENT_QUEUE_LEN];
+static os_event_t _event_task_queue[1];
+static uint8_t _event_queue_head;
+static uint8_t _event_queue_count;
+static uint8_t _event_task_ready;
+static uint8_t _event_task_posted;
+//FALLBACK WHEN THE EVENT TASK PRIORITY IS NOT AVAILABLE
+os_timer_t _event_deliver_timer;
+static uint8_t _event_timer_ready;
+static ESP8266_SSID_FRAMEWORK_EVENT_STATS _event_stats;
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_CONFIG_WEBCONFIG
+//WEBCONFIG RELATED
+os_timer_t _credential_check_timer;
+os_timer_t _credential_retry_timer;
+os_timer_t _portal_teardown_timer;
+os_timer_t _portal_retry_timer;
+static char* _config_page_html;
+static uint16_t _config_page_len;
+static char _config_page_status[ESP8266_SSID_FRAMEWORK_STATUS_STRING_LEN];
+static char _softap_ssid[ESP8266_SSID_FRAMEWORK_SSID_NAME_LEN + 1];
+static struct station_config _credential_check_config;
+static uint8_t _portal_teardown_pending;
+static uint8_t _portal_result_served;
+static uint8_t _credential_check_ip_mode;
+static struct ip_info _credential_check_ip;
+static ip_addr_t _credential_check_dns;
+static uint8_t _credential_check_custom_present;
+static uint8_t _credential_check_custom_values[ESP8266_SSID_FRAMEWORK_CUSTOM_FIELD_STORE_LEN];
+static char* _post_buffer;
+static uint16_t _post_len;
+static uint16_t _post_expected;
+static uint8_t* _session_arena;
+static ESP8266_SSID_FRAMEWORK_ARENA_STATS _session_arena_stats;
+#endif
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_PORTAL_BENCH
+//PORTAL BENCHMARK RELATED
+static uint8_t _bench_active;
+static uint32_t _bench_bytes_copied;
+static uint16_t _bench_allocations;
+static uint32_t _bench_heap_base;
+static uint16_t _bench_peak_heap;
+static uint16_t _bench_arena_base;
+static uint16_t _bench_peak_arena;
+#endif
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_ROAMING
+//ROAMING RELATED
+os_timer_t _roam_sample_timer;
+static uint8_t _roam_enabled;
+static int8_t _roam_rssi_threshold = ESP8266_SSID_FRAMEWORK_ROAM_RSSI_THRESHOLD;
+static int16_t _roam_rssi_avg;
+static uint8_t _roam_rssi_valid;
+static uint32_t _roam_dwell_ms;
+static uint8_t _roam_scanning;
+static uint8_t _roam_in_progress;
+static uint8_t _roam_scan_count;
+static uint8_t _roam_current_bssid[6];
+static struct station_config _roam_station_config;
+static ESP8266_SSID_FRAMEWORK_ROAM_CACHE_ENTRY _roam_cache[ESP8266_SSID_FRAMEWORK_ROAM_CACHE_COUNT];
+static uint8_t _roam_cache_count;
+#endif
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_STATION_MDNS
+//STATION MDNS RELATED
+os_timer_t _mdns_announce_timer;
+static char _mdns_txt[ESP8266_SSID_FRAMEWORK_CUSTOM_FIELD_MAX_COUNT + 1][ESP8266_SSID_FRAMEWORK_MDNS_TXT_LEN];
+static struct mdns_info _mdns_info;
+static uint8_t _mdns_running;
+static uint8_t _mdns_announce_count;
+#endif
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_OTA
+//OTA RELATED
+os_timer_t _ota_idle_timer;
+os_timer_t _ota_reboot_timer;
+static uint8_t _ota_active;
+static uint8_t _ota_failed;
+static char _ota_key[ESP8266_SSID_FRAMEWORK_OTA_KEY_LEN + 1];
+static uint32_t _ota_addr;
+static uint32_t _ota_expected_len;
+static uint32_t _ota_received;
+static uint32_t _ota_written;
+static uint32_t _ota_crc;
+static uint32_t _ota_expected_crc;
+static uint32_t _ota_start_us;
+static uint32_t _ota_buffer[ESP8266_SSID_FRAMEWORK_OTA_WRITE_CHUNK / 4];
+static uint32_t _ota_verify_buffer[ESP8266_SSID_FRAMEWORK_OTA_WRITE_CHUNK / 4];
+static uint16_t _ota_buffer_len;
+static ESP8266_SSID_FRAMEWORK_OTA_STATS _ota_stats;
+#endif
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_STATS
+//CONNECTION STATS RELATED
+//THE LIVE STATS ARE _param_record.stats, SO EVERY PARAMETER SAVE PERSISTS THEM
+os_timer_t _stats_flush_timer;
+static ESP8266_SSID_FRAMEWORK_STATS_RTC_RECORD _stats_rtc;
+static uint8_t _stats_dirty;
+static uint8_t _stats_early_flushed;
+#endif
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_CREDENTIAL_CRYPT
+//CREDENTIAL ENCRYPTION RELATED
+//KEY WORDS 0-7 = CHACHA20 KEY, 8-11 = SIPHASH KEY
+static uint32_t _credential_key[12];
+static uint8_t _credential_keys_ready;
+static uint32_t _credential_decrypt_us;
+#endif
 
 //UTILITY FUNCTIONS
+#if ESP8266_SSID_FRAMEWORK_MODULE_INPUT_HARDCODED || ESP8266_SSID_FRAMEWORK_MODULE_CREDENTIAL_CRYPT
 static bool _esp8266_ssid_framework_check_valid_stationconfig(struct station_config* config);
+#endif
+static bool ICACHE_FLASH_ATTR _esp8266_ssid_framework_reason_is_terminal(uint8_t reason);
+static const char* ICACHE_FLASH_ATTR _esp8266_ssid_framework_reason_string(uint8_t reason);
+static uint8_t ICACHE_FLASH_ATTR _esp8266_ssid_framework_reason_slot(uint8_t reason);
+static void ICACHE_FLASH_ATTR _esp8266_ssid_framework_count_disconnect(uint8_t reason);
+static void ICACHE_FLASH_ATTR _esp8266_ssid_framework_load_candidate(uint8_t source, struct station_config* config);
+static uint8_t ICACHE_FLASH_ATTR _esp8266_ssid_framework_ip_config_store(uint8_t mode, struct ip_info* static_ip, ip_addr_t* static_dns);
+static uint8_t ICACHE_FLASH_ATTR _esp8266_ssid_framework_image_region(uint8_t user2, uint32_t* addr, uint32_t* max_len);
+static uint16_t ICACHE_FLASH_ATTR _esp8266_ssid_framework_param_sector(void);
+static struct netif* ICACHE_FLASH_ATTR _esp8266_ssid_framework_netif_by_ip(ip_addr_t* ip);
+static void ICACHE_FLASH_ATTR _esp8266_ssid_framework_mdns_build_hostname(void);
+static uint8_t ICACHE_FLASH_ATTR _esp8266_ssid_framework_field_size(ESP8266_SSID_FRAMEWORK_CONFIG_USER_FIELD* field);
+static uint8_t* ICACHE_FLASH_ATTR _esp8266_ssid_framework_field_slot(uint8_t index, uint8_t type);
+static void ICACHE_FLASH_ATTR _esp8266_ssid_framework_field_format(uint8_t index, char* text);
+#if ESP8266_SSID_FRAMEWORK_MODULE_CONFIG_WEBCONFIG
+static uint8_t ICACHE_FLASH_ATTR _esp8266_ssid_framework_hex_nibble(char c);
+static void ICACHE_FLASH_ATTR _esp8266_ssid_framework_page_append(const char* str);
+static void ICACHE_FLASH_ATTR _esp8266_ssid_framework_page_append_escaped(const char* str);
+static void ICACHE_FLASH_ATTR _esp8266_ssid_framework_page_append_field(uint8_t index);
+static uint8_t ICACHE_FLASH_ATTR _esp8266_ssid_framework_form_value(char* body, const char* name, char* value, uint8_t value_len);
+static uint8_t ICACHE_FLASH_ATTR _esp8266_ssid_framework_parse_ip(char* str, ip_addr_t* addr);
+static uint8_t ICACHE_FLASH_ATTR _esp8266_ssid_framework_parse_int(char* str, int32_t* value);
+static uint8_t ICACHE_FLASH_ATTR _esp8266_ssid_framework_field_encode(ESP8266_SSID_FRAMEWORK_CONFIG_USER_FIELD* field, char* text, uint8_t* slot);
+static uint8_t ICACHE_FLASH_ATTR _esp8266_ssid_framework_header_value(char* data, const char* name, uint8_t hex, uint32_t* value);
+static void* ICACHE_FLASH_ATTR _esp8266_ssid_framework_portal_alloc(uint16_t len);
+static void ICACHE_FLASH_ATTR _esp8266_ssid_framework_portal_free(void* ptr);
+#endif
+#if ESP8266_SSID_FRAMEWORK_MODULE_STATION_MDNS
+static void ICACHE_FLASH_ATTR _esp8266_ssid_framework_mdns_txt_set(uint8_t index, const char* key, const char* value);
+#endif
+#if ESP8266_SSID_FRAMEWORK_MODULE_OTA
+static uint32_t ICACHE_FLASH_ATTR _esp8266_ssid_framework_crc32_update(uint32_t crc, uint8_t* data, uint16_t len);
+static uint8_t ICACHE_FLASH_ATTR _esp8266_ssid_framework_ota_key_matches(char* data);
+#endif
+#if ESP8266_SSID_FRAMEWORK_MODULE_STATS
+static uint32_t ICACHE_FLASH_ATTR _esp8266_ssid_framework_stats_checksum(ESP8266_SSID_FRAMEWORK_STATS* stats);
+#endif
+#if ESP8266_SSID_FRAMEWORK_MODULE_CREDENTIAL_CRYPT
+static void ICACHE_FLASH_ATTR _esp8266_ssid_framework_chacha20_quarter_round(uint32_t* x, uint8_t a, uint8_t b, uint8_t c, uint8_t d);
+static void ICACHE_FLASH_ATTR _esp8266_ssid_framework_chacha20_xor(const uint32_t* key, uint32_t nonce0, uint32_t nonce1, uint8_t* data, uint16_t len);
+static void ICACHE_FLASH_ATTR _esp8266_ssid_framework_siphash_round(uint64_t* v);
+static void ICACHE_FLASH_ATTR _esp8266_ssid_framework_siphash24(const uint32_t* key, const uint8_t* data, uint16_t len, uint8_t* out);
+#endif
 //END LOCAL LIBRARY VARIABLES/////////////////////////////
 
 void ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_SetDebug(uint8_t debug_on)
@@ -119,6 +315,7 @@ void ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_SetParameters(ESP8266_SSID_FRAMEWO
           os_printf("ESP8266 : SSID FRAMEWORK : Max %u custom fields allowed! Aborting\n", ESP8266_SSID_FRAMEWORK_CUSTOM_FIELD_MAX_COUNT);
       return;
     }
+    _esp8266_ssid_framework_custom_fields_layout();
 
     _input_mode = input_mode;
     _config_mode = config_mode;
@@ -132,29 +329,22 @@ void ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_SetParameters(ESP8266_SSID_FRAMEWO
 
     switch(input_mode)
     {
+#if ESP8266_SSID_FRAMEWORK_MODULE_INPUT_HARDCODED
         case ESP8266_SSID_FRAMEWORK_SSID_INPUT_HARDCODED:
             if(_esp8266_ssid_framework_debug)
                 os_printf("ESP8266 : SSID FRAMEWORK : INPUT MODE = HARDCODED\n");
             _ssid_hardcoded_name_pwd = *(ESP8266_SSID_FRAMEWORK_HARDCODED_SSID_DETAILS*)user_data;
             break;
+#endif
 
-        case ESP8266_SSID_FRAMEWORK_SSID_INPUT_FLASH:
-            if(_esp8266_ssid_framework_debug)
-                os_printf("ESP8266 : SSID FRAMEWORK : INPUT MODE = FLASH\n");
-            _ssid_flash_name_pwd = *(ESP8266_SSID_FRAMEWORK_FLASH_SSID_DETAILS*)user_data;
-            break;
-
-        case ESP8266_SSID_FRAMEWORK_SSID_INPUT_EEPROM:
-            if(_esp8266_ssid_framework_debug)
-                os_printf("ESP8266 : SSID FRAMEWORK : INPUT MODE = EEPROM\n");
-            _ssid_eeprom_name_pwd = *(ESP8266_SSID_FRAMEWORK_EEPROM_SSID_DETAILS*)user_data;
-            break;
-
+#if ESP8266_SSID_FRAMEWORK_MODULE_INPUT_INTERNAL
         case ESP8266_SSID_FRAMEWORK_SSID_INPUT_INTERNAL:
             if(_esp8266_ssid_framework_debug)
                 os_printf("ESP8266 : SSID FRAMEWORK : INPUT MODE = INTERNAL\n");
             break;
+#endif
 
+#if ESP8266_SSID_FRAMEWORK_MODULE_INPUT_GPIO
         case ESP8266_SSID_FRAMEWORK_SSID_INPUT_GPIO:
             if(_esp8266_ssid_framework_debug)
                 os_printf("ESP8266 : SSID FRAMEWORK : INPUT MODE = GPIO @ pin %u\n", *(uint8_t*)user_data);
@@ -162,24 +352,33 @@ void ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_SetParameters(ESP8266_SSID_FRAMEWO
             //SET TRIGGER GPIO AS INPUT
             ESP8266_GPIO_Set_Direction(_ssid_gpio_trigger_pin, 0);
             break;
+#endif
 
         default:
+            if(_esp8266_ssid_framework_debug)
+                os_printf("ESP8266 : SSID FRAMEWORK : INPUT MODE %u not compiled in!\n", input_mode);
             break;
     }
 
     switch(config_mode)
     {
+#if ESP8266_SSID_FRAMEWORK_MODULE_CONFIG_SMARTCONFIG
         case ESP8266_SSID_FRAMEWORK_CONFIG_SMARTCONFIG:
             if(_esp8266_ssid_framework_debug)
                 os_printf("ESP8266 : SSID FRAMEWORK : CONFIG MODE = SMARTCONFIG\n");
             break;
+#endif
 
+#if ESP8266_SSID_FRAMEWORK_MODULE_CONFIG_WEBCONFIG
         case ESP8266_SSID_FRAMEWORK_CONFIG_WEBCONFIG:
             if(_esp8266_ssid_framework_debug)
                 os_printf("ESP8266 : SSID FRAMEWORK : CONFIG MODE = WEBCONFIG\n");
             break;
+#endif
 
         default:
+            if(_esp8266_ssid_framework_debug)
+                os_printf("ESP8266 : SSID FRAMEWORK : CONFIG MODE %u not compiled in!\n", config_mode);
             break;
     }
 
@@ -190,6 +389,7 @@ void ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_SetParameters(ESP8266_SSID_FRAMEWO
     os_timer_setfn(&_status_led_timer, _esp8266_ssid_framework_led_toggle_cb, NULL);
 }
 
+#if ESP8266_SSID_FRAMEWORK_MODULE_INPUT_GPIO
 void ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_SetGpioTriggerLevelSet(ESP8266_SSID_FRAMEWORK_GPIO_TRIGGER level)
 {
     //SET THE TRIGGER LEVEL FOR GPIO TRIGGER
@@ -200,10 +400,12 @@ void ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_SetGpioTriggerLevelSet(ESP8266_SSI
         os_printf("ESP8266 : SSID FRAMEWORK : GPIO Trigger Level = %u!\n", _gpio_trigger_level);
     }
 }
+#endif
 
 void ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_SetCbFunctions(void (*wifi_connected_cb)(char**))
 {
     //SET THE USER CB FUNCTION TO BE CALLED WHEN THE WIFI IS CONNECTED
+    //CALLED FROM THE FRAMEWORK EVENT TASK (SEE ESP8266_SSID_FRAMEWORK_Subscribe)
 
     _esp8266_ssid_framework_wifi_connected_user_cb = wifi_connected_cb;
 
@@ -213,6 +415,172 @@ void ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_SetCbFunctions(void (*wifi_connect
     }
 }
 
+void ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_SetLinkCbFunctions(void (*link_up_cb)(void), void (*link_down_cb)(uint8_t))
+{
+    //SET THE USER CB FUNCTIONS TO BE CALLED EVERY TIME THE WIFI LINK COMES UP
+    //OR GOES DOWN AFTER THE FIRST SUCCESSFULL CONNECTION
+    //LINK DOWN CB GETS THE SDK DISCONNECT REASON (OR LINK_DOWN_PROBE_FAILED)
+    //BOTH ARE CALLED FROM THE FRAMEWORK EVENT TASK
+
+    _esp8266_ssid_framework_link_up_user_cb = link_up_cb;
+    _esp8266_ssid_framework_link_down_user_cb = link_down_cb;
+
+    if(_esp8266_ssid_framework_debug)
+    {
+        os_printf("ESP8266 : SSID FRAMEWORK : Link up/down user cb functions set !\n");
+    }
+}
+
+uint8_t ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_Subscribe(uint32_t mask, void (*listener)(ESP8266_SSID_FRAMEWORK_EVENT*, void*), void* arg)
+{
+    //ADD AN EVENT LISTENER FOR THE EVENT TYPES IN mask (ESP8266_SSID_FRAMEWORK_EVENT_MASK)
+    //LISTENERS ARE CALLED FROM THE FRAMEWORK EVENT TASK, NEVER FROM SDK CALLBACKS
+    //SUBSCRIBING THE SAME LISTENER + ARG AGAIN UPDATES ITS MASK
+    //RETURN 0 IF ALL LISTENER SLOTS ARE TAKEN
+
+    uint8_t i;
+    uint8_t free_slot = ESP8266_SSID_FRAMEWORK_EVENT_LISTENER_MAX_COUNT;
+
+    if(listener == NULL)
+    {
+        return 0;
+    }
+
+    for(i = 0; i < ESP8266_SSID_FRAMEWORK_EVENT_LISTENER_MAX_COUNT; i++)
+    {
+        if(_event_listeners[i].listener == listener && _event_listeners[i].arg == arg)
+        {
+            _event_listeners[i].mask = mask;
+            return 1;
+        }
+        if(_event_listeners[i].listener == NULL && free_slot == ESP8266_SSID_FRAMEWORK_EVENT_LISTENER_MAX_COUNT)
+        {
+            free_slot = i;
+        }
+    }
+
+    if(free_slot == ESP8266_SSID_FRAMEWORK_EVENT_LISTENER_MAX_COUNT)
+    {
+        if(_esp8266_ssid_framework_debug)
+        {
+            os_printf("ESP8266 : SSID FRAMEWORK : Max %u event listeners allowed!\n", ESP8266_SSID_FRAMEWORK_EVENT_LISTENER_MAX_COUNT);
+        }
+        return 0;
+    }
+
+    _event_listeners[free_slot].mask = mask;
+    _event_listeners[free_slot].listener = listener;
+    _event_listeners[free_slot].arg = arg;
+    return 1;
+}
+
+void ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_Unsubscribe(void (*listener)(ESP8266_SSID_FRAMEWORK_EVENT*, void*), void* arg)
+{
+    //REMOVE AN EVENT LISTENER ADDED WITH ESP8266_SSID_FRAMEWORK_Subscribe
+
+    uint8_t i;
+
+    for(i = 0; i < ESP8266_SSID_FRAMEWORK_EVENT_LISTENER_MAX_COUNT; i++)
+    {
+        if(_event_listeners[i].listener == listener && _event_listeners[i].arg == arg)
+        {
+            os_memset(&_event_listeners[i], 0, sizeof(ESP8266_SSID_FRAMEWORK_EVENT_LISTENER));
+        }
+    }
+}
+
+void ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_SetSupervisorParameters(uint32_t probe_interval_ms, uint32_t outage_budget_ms)
+{
+    //SET THE LINK SUPERVISION PARAMETERS
+    //probe_interval_ms = GATEWAY PING INTERVAL (0 = NO PROBING)
+    //outage_budget_ms = MAX OUTAGE BEFORE SSID CONFIGURATION STARTS (0 = NEVER)
+
+    _supervisor_probe_interval_ms = probe_interval_ms;
+    _supervisor_outage_budget_ms = outage_budget_ms;
+
+    if(_esp8266_ssid_framework_debug)
+    {
+        os_printf("ESP8266 : SSID FRAMEWORK : Supervisor probe interval = %u ms | outage budget = %u ms\n",
+                    _supervisor_probe_interval_ms, _supervisor_outage_budget_ms);
+    }
+}
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_ROAMING
+void ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_SetRoaming(uint8_t enable, int8_t rssi_threshold)
+{
+    //ENABLE(1) / DISABLE(0) BACKGROUND ROAMING BETWEEN APS OF THE SAME SSID
+    //ROAMING IS CONSIDERED WHEN THE AVERAGE RSSI DROPS BELOW rssi_threshold (dBm)
+
+    _roam_enabled = enable;
+    _roam_rssi_threshold = rssi_threshold;
+
+    if(!_roam_enabled)
+    {
+        os_timer_disarm(&_roam_sample_timer);
+    }
+    else if(_esp8266_ssid_framework_state == ESP8266_SSID_FRAMEWORK_STATE_CONNECTED)
+    {
+        _esp8266_ssid_framework_roam_start();
+    }
+
+    if(_esp8266_ssid_framework_debug)
+    {
+        os_printf("ESP8266 : SSID FRAMEWORK : Roaming %s (threshold %d dBm)\n", _roam_enabled ? "on" : "off", _roam_rssi_threshold);
+    }
+}
+#endif
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_OTA
+void ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_SetOtaKey(char* key)
+{
+    //SET THE KEY A FIRMWARE UPLOAD MUST CARRY (ENTERED NEXT TO THE FILE ON THE
+    //CONFIG PAGE). USE A PER DEVICE VALUE, E.G. PRINTED ON THE DEVICE LABEL
+    //NULL OR A KEY SHORTER THAN OTA_KEY_MIN_LEN = EVERY UPLOAD IS REFUSED
+
+    os_memset(_ota_key, 0, sizeof(_ota_key));
+    if(key != NULL && os_strlen(key) >= ESP8266_SSID_FRAMEWORK_OTA_KEY_MIN_LEN)
+    {
+        strncpy(_ota_key, key, ESP8266_SSID_FRAMEWORK_OTA_KEY_LEN);
+    }
+    else if(_esp8266_ssid_framework_debug)
+    {
+        os_printf("ESP8266 : SSID FRAMEWORK : No usable OTA key. Firmware uploads disabled\n");
+    }
+}
+#endif
+
+void ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_SetIpMode(ESP8266_SSID_FRAMEWORK_IP_MODE mode, struct ip_info* static_ip, ip_addr_t* static_dns)
+{
+    //SET HOW THE STATION GETS ITS IP ADDRESS. SAVED IN FLASH, USED FROM THE NEXT CONNECT
+    //static_ip (+ OPTIONAL static_dns) ONLY NEEDED FOR STATIC MODE
+    //THE CONFIG PAGE CAN CHANGE THIS TOO. DO NOT CALL IT ON EVERY BOOT IF THE
+    //PAGE SETTING SHOULD STICK
+
+    ip_addr_t no_dns;
+
+    if(mode >= ESP8266_SSID_FRAMEWORK_IP_MODE_COUNT ||
+        (mode == ESP8266_SSID_FRAMEWORK_IP_MODE_STATIC && static_ip == NULL))
+    {
+        if(_esp8266_ssid_framework_debug)
+        {
+            os_printf("ESP8266 : SSID FRAMEWORK : Invalid ip mode settings!\n");
+        }
+        return;
+    }
+
+    no_dns.addr = 0;
+    _esp8266_ssid_framework_param_load();
+    if(_esp8266_ssid_framework_ip_config_store(mode, static_ip, (static_dns != NULL) ? static_dns : &no_dns))
+    {
+        _esp8266_ssid_framework_param_save();
+    }
+
+    if(_esp8266_ssid_framework_debug)
+    {
+        os_printf("ESP8266 : SSID FRAMEWORK : IP mode = %u\n", mode);
+    }
+}
+
 void ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_Initialize(void)
 {
     //START THE SSID FRAMEWORK WITH THE SET PARAMETERS
@@ -222,15 +590,38 @@ void ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_Initialize(void)
         os_printf("ESP8266 : SSID FRAMEWORK : Running !\n");
     }
 
-    //ALLOCATE BUFFER FOR CONFIG PAGE HTML
-    _config_page_html = (char*)os_zalloc(3000);
-
     //START LED TOGGLE @ 250ms
     os_timer_arm(&_status_led_timer, 250, 1);
 
+    //LOAD SAVED FRAMEWORK PARAMETERS (IP MODE, LAST LEASE, CUSTOM FIELD VALUES)
+    _esp8266_ssid_framework_param_load();
+    _esp8266_ssid_framework_custom_fields_publish();
+#if ESP8266_SSID_FRAMEWORK_MODULE_STATS
+    _esp8266_ssid_framework_stats_load();
+#endif
+    os_timer_setfn(&_ip_lease_verify_timer, _esp8266_ssid_framework_ip_lease_verify_timer_cb, NULL);
+
+    //DEVICE HOSTNAME (MDNS)
+    _esp8266_ssid_framework_mdns_build_hostname();
+
+    //EVENT DELIVERY TASK (EVENTS QUEUED BEFORE THIS ARE DELIVERED NOW)
+    _event_task_ready = system_os_task(_esp8266_ssid_framework_event_task, ESP8266_SSID_FRAMEWORK_EVENT_TASK_PRIO, _event_task_queue, 1);
+    if(!_event_task_ready)
+    {
+        //PRIORITY ALREADY TAKEN. ALWAYS PRINTED, DELIVERY FALLS BACK TO A TIMER
+        os_printf("ESP8266 : SSID FRAMEWORK : Event task priority %u not available! Delivering events from a timer\n", ESP8266_SSID_FRAMEWORK_EVENT_TASK_PRIO);
+        os_timer_setfn(&_event_deliver_timer, _esp8266_ssid_framework_event_deliver_timer_cb, NULL);
+        _event_timer_ready = 1;
+    }
+    if(_event_queue_count != 0)
+    {
+        _esp8266_ssid_framework_event_schedule();
+    }
+
     //SET WIFI EVENTS FUNCTION
     wifi_set_event_handler_cb(_esp8266_ssid_framework_wifi_event_handler_cb);
 
+#if ESP8266_SSID_FRAMEWORK_MODULE_INPUT_GPIO
     //SPECIAL CASE: CHECK FOR GPIO TRIGGER IF FRAMEWORK INPUT = GPIO
     if(_input_mode == ESP8266_SSID_FRAMEWORK_SSID_INPUT_GPIO && ESP8266_GPIO_Get_Value(_ssid_gpio_trigger_pin) == _gpio_trigger_level)
     {
@@ -240,13 +631,296 @@ void ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_Initialize(void)
             os_printf("ESP8266 : SSID FRAMEWORK : GPIO input triggered !\n");
         }
         _esp8266_ssid_framework_wifi_start_ssid_configuration();
+        return;
+    }
+#endif
+
+    //START WIFI CONNECTION ATTEMPT
+    _esp8266_ssid_framework_wifi_start_connection_process(NULL);
+}
+
+ESP8266_SSID_FRAMEWORK_STATE ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_GetState(void)
+{
+    //RETURN THE CURRENT SSID FRAMEWORK STATE
+
+    return _esp8266_ssid_framework_state;
+}
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_ROAMING
+int8_t ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_GetAverageRssi(void)
+{
+    //RETURN THE MOVING AVERAGE RSSI OF THE CURRENT LINK (ROAMING ENABLED ONLY)
+    //0 IF NO SAMPLES YET
+
+    if(!_roam_rssi_valid)
+    {
+        return 0;
+    }
+    return (int8_t)(_roam_rssi_avg >> ESP8266_SSID_FRAMEWORK_ROAM_RSSI_AVG_SHIFT);
+}
+#endif
+
+uint16_t ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_GetDisconnectCount(uint8_t reason)
+{
+    //RETURN NUMBER OF WIFI DISCONNECTS SEEN FOR SPECIFIED REASON CODE
+    //REASON CODES NOT TRACKED INDIVIDUALLY ARE COUNTED UNDER REASON 0
+
+    return _disconnect_reason_counts[_esp8266_ssid_framework_reason_slot(reason)];
+}
+
+void ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_ResetDisconnectCounts(void)
+{
+    //RESET ALL PER REASON WIFI DISCONNECT COUNTERS
+
+    os_memset(_disconnect_reason_counts, 0, sizeof(_disconnect_reason_counts));
+}
+
+ESP8266_SSID_FRAMEWORK_IP_MODE ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_GetIpMode(void)
+{
+    //RETURN THE CONFIGURED (SAVED) IP MODE
+
+    _esp8266_ssid_framework_param_load();
+    return _param_record.ip_mode;
+}
+
+uint32_t ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_GetTimeToIp(ESP8266_SSID_FRAMEWORK_IP_MODE mode)
+{
+    //RETURN THE LAST MEASURED TIME (ms) FROM CONNECT START TO USABLE IP FOR
+    //SPECIFIED MODE. LEASE REUSE INCLUDES THE ARP CHECK. 0 = NOT MEASURED YET
+
+    if(mode >= ESP8266_SSID_FRAMEWORK_IP_MODE_COUNT)
+    {
+        return 0;
+    }
+    return _ip_time_to_ip_ms[mode];
+}
+
+char* ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_GetHostname(void)
+{
+    //RETURN THE DEVICE MDNS HOSTNAME (WITHOUT .local)
+    //VALID AFTER ESP8266_SSID_FRAMEWORK_Initialize
+
+    return _mdns_hostname;
+}
+
+void ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_GetEventStats(ESP8266_SSID_FRAMEWORK_EVENT_STATS* stats)
+{
+    //COPY THE EVENT QUEUE STATS (CURRENT DEPTH, HIGH WATER MARK, POSTED, DROPPED)
+
+    os_memcpy(stats, &_event_stats, sizeof(ESP8266_SSID_FRAMEWORK_EVENT_STATS));
+    stats->depth = _event_queue_count;
+}
+
+char* ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_GetFieldString(uint8_t index)
+{
+    //RETURN THE STORED VALUE OF STRING CUSTOM FIELD index
+    //NULL IF THE FIELD IS NOT A STRING OR HAS NO VALUE
+
+    return (char*)_esp8266_ssid_framework_field_slot(index, ESP8266_SSID_FRAMEWORK_FIELD_STRING);
+}
+
+uint8_t ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_GetFieldInt(uint8_t index, int32_t* value)
+{
+    //READ THE STORED VALUE OF INT CUSTOM FIELD index
+    //RETURN 0 IF THE FIELD IS NOT AN INT OR HAS NO VALUE
+
+    uint8_t* slot = _esp8266_ssid_framework_field_slot(index, ESP8266_SSID_FRAMEWORK_FIELD_INT);
+
+    if(slot == NULL)
+    {
+        return 0;
+    }
+    os_memcpy(value, slot, sizeof(int32_t));
+    return 1;
+}
+
+uint8_t ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_GetFieldBool(uint8_t index, uint8_t* value)
+{
+    //READ THE STORED VALUE OF BOOL CUSTOM FIELD index
+    //RETURN 0 IF THE FIELD IS NOT A BOOL OR HAS NO VALUE
+
+    uint8_t* slot = _esp8266_ssid_framework_field_slot(index, ESP8266_SSID_FRAMEWORK_FIELD_BOOL);
+
+    if(slot == NULL)
+    {
+        return 0;
+    }
+    *value = *slot;
+    return 1;
+}
+
+uint8_t ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_GetFieldIp(uint8_t index, ip_addr_t* value)
+{
+    //READ THE STORED VALUE OF IPV4 CUSTOM FIELD index
+    //RETURN 0 IF THE FIELD IS NOT AN IPV4 FIELD OR HAS NO VALUE
+
+    uint8_t* slot = _esp8266_ssid_framework_field_slot(index, ESP8266_SSID_FRAMEWORK_FIELD_IPV4);
+
+    if(slot == NULL)
+    {
+        return 0;
+    }
+    os_memcpy(value, slot, sizeof(ip_addr_t));
+    return 1;
+}
+
+uint8_t ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_GetFieldEnum(uint8_t index, uint8_t* value)
+{
+    //READ THE STORED OPTION INDEX OF ENUM CUSTOM FIELD index
+    //RETURN 0 IF THE FIELD IS NOT AN ENUM OR HAS NO VALUE
+
+    uint8_t* slot = _esp8266_ssid_framework_field_slot(index, ESP8266_SSID_FRAMEWORK_FIELD_ENUM);
+
+    if(slot == NULL)
+    {
+        return 0;
+    }
+    *value = *slot;
+    return 1;
+}
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_OTA
+void ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_GetOtaStats(ESP8266_SSID_FRAMEWORK_OTA_STATS* stats)
+{
+    //COPY THE STATS OF THE LAST FIRMWARE UPLOAD (ALL 0 IF NONE SINCE BOOT)
+
+    os_memcpy(stats, &_ota_stats, sizeof(ESP8266_SSID_FRAMEWORK_OTA_STATS));
+}
+#endif
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_STATS
+void ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_GetStats(ESP8266_SSID_FRAMEWORK_STATS* stats)
+{
+    //COPY THE CONNECTION STATS (KEPT ACROSS REBOOTS)
+    //VALID AFTER ESP8266_SSID_FRAMEWORK_Initialize
+
+    os_memcpy(stats, &_param_record.stats, sizeof(ESP8266_SSID_FRAMEWORK_STATS));
+}
+
+void ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_ResetStats(void)
+{
+    //CLEAR ALL CONNECTION STATS (INCLUDING THE BOOT COUNT)
+    //SAVED TO FLASH AT ONCE. THE RTC COPY WINS ONLY IF ITS BOOT COUNT IS NOT
+    //BEHIND THE FLASH COPY, SO AN OLDER FLASH COPY WOULD UNDO THE RESET
+
+    os_memset(&_param_record.stats, 0, sizeof(ESP8266_SSID_FRAMEWORK_STATS));
+    _esp8266_ssid_framework_stats_changed();
+    _esp8266_ssid_framework_param_save();
+}
+#endif
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_CREDENTIAL_CRYPT
+uint32_t ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_GetCredentialDecryptTime(void)
+{
+    //RETURN THE TIME (us) OF THE LAST CREDENTIAL DECRYPT INCLUDING THE MAC CHECK
+    //(AND THE KEY DERIVATION ON THE FIRST ONE). 0 = NONE YET
+
+    return _credential_decrypt_us;
+}
+#endif
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_CONFIG_WEBCONFIG
+void ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_GetArenaStats(ESP8266_SSID_FRAMEWORK_ARENA_STATS* stats)
+{
+    //COPY THE SESSION ARENA USE OF THE CURRENT OR LAST PROVISIONING SESSION
+
+    os_memcpy(stats, &_session_arena_stats, sizeof(ESP8266_SSID_FRAMEWORK_ARENA_STATS));
+}
+#endif
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_PORTAL_BENCH
+uint8_t ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_RunPortalBenchmark(uint8_t field_count, uint8_t iterations, ESP8266_SSID_FRAMEWORK_BENCH_RESULT* result)
+{
+    //REPLAY A GET /config, A FORM POST AND THE SAME POST IN FRAGMENTS THROUGH
+    //THE PORTAL REQUEST PATH AND MEASURE EACH KIND (SEE BENCH_RESULT)
+    //THE POST IS A DRY RUN : PARSED AND VALIDATED, NO CREDENTIAL CHECK STARTS
+    //ONLY THE FIRST field_count CUSTOM FIELDS ARE USED. BLOCKS FOR THE WHOLE RUN
+    //RETURN 0 IF A CREDENTIAL CHECK OR A FRAGMENTED POST IS IN PROGRESS
+
+    ESP8266_SSID_FRAMEWORK_CONFIG_USER_FIELD_GROUP* saved_group = _custom_user_field_group;
+    ESP8266_SSID_FRAMEWORK_CONFIG_USER_FIELD_GROUP group;
+    ESP8266_SSID_FRAMEWORK_STATE saved_state = _esp8266_ssid_framework_state;
+    char saved_status[ESP8266_SSID_FRAMEWORK_STATUS_STRING_LEN];
+    uint8_t own_arena = 0;
+    char* request;
+
+    if(saved_state == ESP8266_SSID_FRAMEWORK_STATE_CHECKING_CREDENTIALS || _post_buffer != NULL)
+    {
+        return 0;
+    }
+
+    request = (char*)os_zalloc(ESP8266_SSID_FRAMEWORK_POST_MAX_LEN);
+    if(request == NULL)
+    {
+        return 0;
+    }
+    if(_config_page_html == NULL)
+    {
+        //PORTAL NOT RUNNING. USE A TEMPORARY SESSION ARENA
+        if(!_esp8266_ssid_framework_arena_reserve())
+        {
+            os_free(request);
+            return 0;
+        }
+        own_arena = 1;
+    }
+
+    if(iterations == 0 || iterations > ESP8266_SSID_FRAMEWORK_BENCH_MAX_ITERATIONS)
+    {
+        iterations = ESP8266_SSID_FRAMEWORK_BENCH_MAX_ITERATIONS;
+    }
+    if(saved_group == NULL)
+    {
+        field_count = 0;
     }
     else
     {
-        //START WIFI CONNECTION ATTEMPT
-        _esp8266_ssid_framework_wifi_start_connection_process(NULL);
+        if(field_count > saved_group->custom_fields_count)
+        {
+            field_count = saved_group->custom_fields_count;
+        }
+        group.custom_fields = saved_group->custom_fields;
+        group.custom_fields_count = field_count;
+        _custom_user_field_group = &group;
+    }
+    os_strcpy(saved_status, _config_page_status);
+
+    os_memset(result, 0, sizeof(ESP8266_SSID_FRAMEWORK_BENCH_RESULT));
+    result->field_count = field_count;
+    result->iterations = iterations;
+
+    //THE POST HANDLER ONLY ACCEPTS FORMS WHILE PROVISIONING
+    _bench_active = 1;
+    _esp8266_ssid_framework_state = ESP8266_SSID_FRAMEWORK_STATE_PROVISIONING;
+    _esp8266_ssid_framework_bench_request(request);
+    result->request_len = os_strlen(request);
+    _esp8266_ssid_framework_bench_measure(ESP8266_SSID_FRAMEWORK_BENCH_GET, request, iterations, &result->get);
+    _esp8266_ssid_framework_bench_measure(ESP8266_SSID_FRAMEWORK_BENCH_POST, request, iterations, &result->post);
+    _esp8266_ssid_framework_bench_measure(ESP8266_SSID_FRAMEWORK_BENCH_POST_FRAGMENTED, request, iterations, &result->post_fragmented);
+    _esp8266_ssid_framework_state = saved_state;
+    _bench_active = 0;
+
+    _custom_user_field_group = saved_group;
+    os_strcpy(_config_page_status, saved_status);
+    if(own_arena)
+    {
+        _esp8266_ssid_framework_arena_release();
+    }
+    else
+    {
+        //PUT BACK THE PAGE THE PORTAL SERVES
+        _esp8266_ssid_framework_generate_config_page();
+    }
+    os_free(request);
+
+    if(_esp8266_ssid_framework_debug)
+    {
+        os_printf("ESP8266 : SSID FRAMEWORK : Portal benchmark %u fields x %u : GET p50 %u us, POST p50 %u us, fragmented p50 %u us\n",
+                    field_count, iterations, result->get.p50_us, result->post.p50_us, result->post_fragmented.p50_us);
     }
+    return 1;
 }
+#endif
 
 void ICACHE_FLASH_ATTR _esp8266_ssid_framework_led_toggle_cb(void* pArg)
 {
@@ -270,31 +944,24 @@ void ICACHE_FLASH_ATTR _esp8266_ssid_framework_wifi_connect_timer_cb(void* pArg)
         }
         _ssid_connect_retry_count++;
 
-        //ARM THE TIMER
-        os_timer_arm(&_wifi_connect_timer, _ssid_connect_retry_delay_ms, 0);
-
         if(_ssid_connect_retry_count > _ssid_connect_retries)
         {
-            //ALL TRIES EXPIRED
+            //ALL TRIES EXPIRED FOR THIS CANDIDATE
             if(_esp8266_ssid_framework_debug)
             {
-                os_printf("ESP8266 : SSID FRAMEWORK : wifi connection tries finished\n", _ssid_connect_retry_count);
+                os_printf("ESP8266 : SSID FRAMEWORK : wifi connection tries finished\n");
             }
 
-            //DISARM THE TIMER
-            os_timer_disarm(&_wifi_connect_timer);
-
-            //START THE SSID CONFIGURATION PROCESS
-            _esp8266_ssid_framework_wifi_start_ssid_configuration();
+            //MOVE ON TO THE NEXT CANDIDATE (OR SSID CONFIGURATION)
+            _ssid_candidate_index++;
+            _esp8266_ssid_framework_wifi_connect_candidate();
         }
         else
         {
+            //ARM THE TIMER
+            os_timer_arm(&_wifi_connect_timer, _ssid_connect_retry_delay_ms, 0);
+
             //ATTEMPT CONNECT TO WIFI AGAIN
-            struct station_config* sconfig = (struct station_config*)pArg;
-            if(sconfig != NULL)
-            {
-                wifi_station_set_config(sconfig);
-            }
             wifi_station_connect();
         }
     }
@@ -314,6 +981,9 @@ void ICACHE_FLASH_ATTR _esp8266_ssid_framework_wifi_event_handler_cb(System_Even
     {
         case EVENT_STAMODE_CONNECTED:
             _esp8266_ssid_framework_wifi_connected = 1;
+#if ESP8266_SSID_FRAMEWORK_MODULE_ROAMING
+            os_memcpy(_roam_current_bssid, event->event_info.connected.bssid, 6);
+#endif
             if(_esp8266_ssid_framework_debug)
             {
                 os_printf("ESP8266 : SSID FRAMEWORK : wifi event CONNECTED\n");
@@ -321,9 +991,59 @@ void ICACHE_FLASH_ATTR _esp8266_ssid_framework_wifi_event_handler_cb(System_Even
             break;
         case EVENT_STAMODE_DISCONNECTED:
             _esp8266_ssid_framework_wifi_connected = 0;
+            _esp8266_ssid_framework_count_disconnect(event->event_info.disconnected.reason);
+            _esp8266_ssid_framework_event_post(ESP8266_SSID_FRAMEWORK_EVENT_DISCONNECTED, event->event_info.disconnected.reason, NULL, NULL);
+            //A PENDING LEASE CHECK IS REDONE ON THE NEXT GOT IP
+            os_timer_disarm(&_ip_lease_verify_timer);
             if(_esp8266_ssid_framework_debug)
             {
-                os_printf("ESP8266 : SSID FRAMEWORK : wifi event DISCONNECTED\n");
+                os_printf("ESP8266 : SSID FRAMEWORK : wifi event DISCONNECTED (reason %u : %s)\n",
+                            event->event_info.disconnected.reason,
+                            _esp8266_ssid_framework_reason_string(event->event_info.disconnected.reason));
+            }
+#if ESP8266_SSID_FRAMEWORK_MODULE_CONFIG_WEBCONFIG
+            if(_esp8266_ssid_framework_state == ESP8266_SSID_FRAMEWORK_STATE_CHECKING_CREDENTIALS && !_portal_teardown_pending)
+            {
+                //CREDENTIAL CHECK IN PROGRESS
+                //TERMINAL REASONS (WRONG PASSWORD, AP GONE) FAIL THE CHECK IMMEDIATELY
+                //OTHERS ARE RETRIED UNTIL THE CREDENTIAL CHECK TIMER EXPIRES
+                //(FROM A TIMER, NOT FROM INSIDE THE SDK EVENT CB)
+                if(_esp8266_ssid_framework_reason_is_terminal(event->event_info.disconnected.reason))
+                {
+                    _esp8266_ssid_framework_credential_check_finish(0, (char*)_esp8266_ssid_framework_reason_string(event->event_info.disconnected.reason));
+                }
+                else
+                {
+                    os_timer_disarm(&_credential_retry_timer);
+                    os_timer_arm(&_credential_retry_timer, ESP8266_SSID_FRAMEWORK_RECONNECT_BACKOFF_MIN_MS, 0);
+                }
+            }
+            else
+#endif
+            if(_esp8266_ssid_framework_state == ESP8266_SSID_FRAMEWORK_STATE_CONNECTED)
+            {
+#if ESP8266_SSID_FRAMEWORK_MODULE_ROAMING
+                if(_roam_in_progress && event->event_info.disconnected.reason == REASON_ASSOC_LEAVE)
+                {
+                    //OWN DISCONNECT FROM THE OLD BSSID WHILE ROAMING
+                    break;
+                }
+                //LINK LOST AFTER BEING CONNECTED (OR ROAMING FAILED)
+                _roam_in_progress = 0;
+#endif
+                _esp8266_ssid_framework_supervisor_link_lost(event->event_info.disconnected.reason);
+            }
+            else if(_esp8266_ssid_framework_state == ESP8266_SSID_FRAMEWORK_STATE_CONNECTING &&
+                        _esp8266_ssid_framework_reason_is_terminal(event->event_info.disconnected.reason))
+            {
+                //TERMINAL FAILURE. RETRYING THESE CREDENTIALS WILL NOT HELP
+                //SKIP STRAIGHT TO THE NEXT CANDIDATE (OR SSID CONFIGURATION)
+                if(_esp8266_ssid_framework_debug)
+                {
+                    os_printf("ESP8266 : SSID FRAMEWORK : Terminal failure. Skipping remaining tries\n");
+                }
+                _ssid_candidate_index++;
+                _esp8266_ssid_framework_wifi_connect_candidate();
             }
             break;
         case EVENT_STAMODE_AUTHMODE_CHANGE:
@@ -333,28 +1053,22 @@ void ICACHE_FLASH_ATTR _esp8266_ssid_framework_wifi_event_handler_cb(System_Even
             }
             break;
         case EVENT_STAMODE_GOT_IP:
-            //DEVICE CONNECTED TO WIFI. CALL USER CB FUNCTION
-            //TO START THE APPLICATION
-            //CALL USER CB IF NOT NULL
             _esp8266_ssid_framework_wifi_connected = 1;
-            //STOP STATUS LED TOGGLING
-            os_timer_disarm(&_status_led_timer);
-            //TURN OFF LED
-            ESP8266_GPIO_Set_Value(_led_gpio_pin, 0);
-            if(_esp8266_ssid_framework_wifi_connected_user_cb != NULL)
+            if(_ip_lease_verifying)
             {
-                //DELAY NEEDED TO LET ESP8266 SAVE SSID/PASSWORD IN FLASH
-                //ADDED TO AVOID CRASHING IF THE USER DOES ANY FLASH OPERATION
-                //AS SOON AS THE USER WIFI CONNECTED CB FUNCTION IS EXECUTED
-                os_delay_us(1000000);
-                (*_esp8266_ssid_framework_wifi_connected_user_cb)(_user_data_ptrs);
+                //REUSED LEASE IS CHECKED FOR CONFLICTS BEFORE THE LINK IS REPORTED UP
+                _esp8266_ssid_framework_ip_lease_verify_start();
+                break;
             }
+            _esp8266_ssid_framework_wifi_got_ip();
             break;
         case EVENT_SOFTAPMODE_STACONNECTED:
             if(_esp8266_ssid_framework_debug)
             {
                 os_printf("ESP8266 : SSID FRAMEWORK : wifi event SOFTAP STA CONNECTED\n");
             }
+            _esp8266_ssid_framework_event_post(ESP8266_SSID_FRAMEWORK_EVENT_PORTAL_CLIENT_JOINED, event->event_info.sta_connected.aid,
+                                                event->event_info.sta_connected.mac, NULL);
             break;
         case EVENT_SOFTAPMODE_STADISCONNECTED:
             if(_esp8266_ssid_framework_debug)
@@ -370,471 +1084,3791 @@ void ICACHE_FLASH_ATTR _esp8266_ssid_framework_wifi_event_handler_cb(System_Even
     }
 }
 
-void ICACHE_FLASH_ATTR _esp8266_ssid_framework_wifi_start_ssid_configuration(void)
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_wifi_got_ip(void)
 {
-    //START THE SSID CONFIGURATION BASED ON CONFIG MODE
+    //STATION HAS A USABLE IP ADDRESS
+    //RECORD TIME TO IP, KEEP A FRESH DHCP LEASE FOR REUSE, MOVE THE STATE MACHINE ON
 
-    if(_config_mode == ESP8266_SSID_FRAMEWORK_CONFIG_SMARTCONFIG)
+    if(_ip_timing)
     {
-        //START SMARTCONFIG
+        uint8_t mode = ESP8266_SSID_FRAMEWORK_IP_MODE_DHCP;
+        if(_ip_connect_mode == ESP8266_SSID_FRAMEWORK_IP_MODE_STATIC)
+        {
+            mode = ESP8266_SSID_FRAMEWORK_IP_MODE_STATIC;
+        }
+        else if(_ip_lease_reused)
+        {
+            mode = ESP8266_SSID_FRAMEWORK_IP_MODE_LEASE_REUSE;
+        }
+        _ip_timing = 0;
+        _ip_time_to_ip_ms[mode] = (system_get_time() - _ip_connect_start_us) / 1000;
+#if ESP8266_SSID_FRAMEWORK_MODULE_STATS
+        _esp8266_ssid_framework_stats_count_time_to_ip(_ip_time_to_ip_ms[mode]);
+        if(!_stats_early_flushed)
+        {
+            //FIRST IP OF THIS BOOT : BRING THE EARLY FLUSH FORWARD, BUT
+            //LEAVE THE SDK TIME TO FINISH ITS OWN FLASH WRITES FIRST
+            os_timer_disarm(&_stats_flush_timer);
+            os_timer_arm(&_stats_flush_timer, ESP8266_SSID_FRAMEWORK_CONNECTED_CB_DELAY_MS, 0);
+        }
+#endif
         if(_esp8266_ssid_framework_debug)
         {
-            os_printf("ESP8266 : SSID FRAMEWORK : Starting config = smartconfig\n");
+            os_printf("ESP8266 : SSID FRAMEWORK : Time to IP = %u ms (ip mode %u)\n", _ip_time_to_ip_ms[mode], mode);
         }
-        ESP8266_SMARTCONFIG_SetDebug(_esp8266_ssid_framework_debug);
-        ESP8266_SMARTCONFIG_Initialize();
-        ESP8266_SMARTCONFIG_Start();
     }
-    else if(_config_mode == ESP8266_SSID_FRAMEWORK_CONFIG_WEBCONFIG)
+
+    if(_ip_connect_mode == ESP8266_SSID_FRAMEWORK_IP_MODE_LEASE_REUSE && !_ip_lease_reused)
     {
-        //START TCP SERVER WEBCONFIG
-        if(_esp8266_ssid_framework_debug)
+        //GOT THE ADDRESS FROM DHCP. SAVE IT IF IT CHANGED
+        struct ip_info info;
+        struct station_config config;
+        ip_addr_t dns = espconn_dns_getserver(0);
+        wifi_get_ip_info(STATION_IF, &info);
+        wifi_station_get_config(&config);
+        if(os_memcmp(&info, &_param_record.lease, sizeof(struct ip_info)) != 0 ||
+            dns.addr != _param_record.lease_dns.addr ||
+            os_strncmp((char*)config.ssid, (char*)_param_record.lease_ssid, ESP8266_SSID_FRAMEWORK_SSID_NAME_LEN) != 0)
         {
-            os_printf("ESP8266 : SSID FRAMEWORK : Starting config = webconfig\n");
+            _param_record.lease = info;
+            _param_record.lease_dns = dns;
+            os_memcpy(_param_record.lease_ssid, config.ssid, ESP8266_SSID_FRAMEWORK_SSID_NAME_LEN);
+            _esp8266_ssid_framework_param_save();
         }
+    }
 
-        //START ESP8266 IN SOFTAP MODE
-        _esp8266_ssid_framework_wifi_start_softap();
+#if ESP8266_SSID_FRAMEWORK_MODULE_CONFIG_WEBCONFIG
+    if(_esp8266_ssid_framework_state == ESP8266_SSID_FRAMEWORK_STATE_CHECKING_CREDENTIALS)
+    {
+        //SUBMITTED CREDENTIALS WORK. PORTAL IS TORN DOWN LATER
+        if(!_portal_teardown_pending)
+        {
+            _esp8266_ssid_framework_credential_check_finish(1, "Connected");
+        }
+    }
+    else
+#endif
+    if(_esp8266_ssid_framework_state != ESP8266_SSID_FRAMEWORK_STATE_CONNECTED)
+    {
+        //CONNECTION PROCESS, LINK RECOVERY (OR SMARTCONFIG) SUCCESSFULL
+        _esp8266_ssid_framework_wifi_on_connected();
+    }
+#if ESP8266_SSID_FRAMEWORK_MODULE_ROAMING
+    else if(_roam_in_progress)
+    {
+        //ROAMED TO NEW BSSID. START AVERAGING AFRESH
         if(_esp8266_ssid_framework_debug)
         {
-            os_printf("ESP8266 : SSID FRAMEWORK : Starting SSID = ESP8266\n");
-        }
-
-        //START TCP SERVER - SOFTAP MODE
-        ESP8266_TCP_SERVER_SetDebug(_esp8266_ssid_framework_debug);
-        ESP8266_TCP_SERVER_Initialize(80, 1200, 1);
-        ESP8266_TCP_SERVER_SetDataEndingString("\r\n\r\n");
-        ESP8266_TCP_SERVER_SetCallbackFunctions(NULL, NULL, NULL, NULL, _esp8266_ssid_framework_tcp_server_post_data_cb);
-
-        //REGISTER PATH CALLBACKS
-        ESP8266_TCP_SERVER_PATH_CB_ENTRY config_path;
-        config_path.path_string = ESP8266_SSID_FRAMEWORK_WEBCONFIG_PATH_STRING;
-        config_path.path_cb_fn = _esp8266_ssid_framework_tcp_server_path_config_cb;
-        config_path.path_found = 0;
-
-        //GENERATE THE CONFIG PAGE HTML
-        strcpy(_config_page_html, "HTTP/1.1 200 OK\r\n"
-                                    "Connection: Closed\r\n"
-                                    "Content-type: text/html"
-                                    "\r\n\r\n"
-                                    "<!DOCTYPE html>"
-                                    "<html><head><title>ESP8266 Web Config</title>"
-                                    "<style>"
-                                    "html{box-sizing:border-box;font-family:sans-serif;line-height:1.15;-webkit-text-size-adjust:100%;}"
-                                    "</style>"
-                                    "</head>"
-                                    "<body>"
-                                    "<table border=\"0\" cellpadding=\"3\" cellspacing=\"1\" style=\"width:420px;\">"
-                                    "<tbody>"
-                                    "<tr>"
-                                    "<td style=\"text-align: left; vertical-align: middle; background-color: rgb(204, 51, 51);\">"
-                                    "<span style=\"color:#FFFFFF;\"><strong><span style=\"font-size: 18px;\">ESP8266 : Web Config</span></strong></span>"
-                                    "</td>"
-                                    "</tr>"
-                                    "<td style=\"text-align: left; vertical-align: middle; background-color: rgb(204, 51, 51);\">"
-                                    "<span style=\"color:#FFFFFF;\"><strong><span style=\"font-size: 18px;\">");
-
-        //ADD PROJECT NAME
-        strcpy(&_config_page_html[os_strlen(_config_page_html)], _project_name);
-        strcpy(&_config_page_html[os_strlen(_config_page_html)], "</span></strong></span>");
-
-        //ADD COMMON CONFIGURATION
-        strcpy(&_config_page_html[os_strlen(_config_page_html)], "</td>"
-                                                                    "</tbody>"
-                                                                    "</table>"
-                                                                    "<form action=\"/config\" method=\"POST\">"
-                                                                    "<table align=\"left\" border=\"0\" cellpadding=\"1\" cellspacing=\"1\" style=\"width:420px;\">"
-                                                                    "<tbody>"
-                                                                    "<tr>"
-                                                                    "<td colspan=\"2\" style=\"background-color: rgb(255, 204, 51);\"><span style=\"font-size:18px;\"><strong>Basic Configuration</strong></span></td>"
-                                                                    "</tr>");
-
-
-        //ADD SSID / PASSWORD INPUT
-        //FILL WITH SAVED ONES IF PRESENT
-        struct station_config config;
-        char* temp_str = (char*)os_zalloc(150);
-        char* format_str = "<td><input type=\"text\" name=\"%s\"></td>";
-        wifi_station_get_config(&config);
-        if(config.ssid[0] >= 28 && config.ssid[0] <= 126 && config.password[0] >= 28 && config.password[0] <= 126)
-        {
-            //SAVED WIFI CREDENTIALS PRESENT
-            strcpy(&_config_page_html[os_strlen(_config_page_html)], "<tr>"
-                                                                        "<td style=\"background-color: rgb(0, 0, 0); text-align: left; vertical-align: middle;\">"
-                                                                        "<span style=\"color:#FFFFFF;\">SSID</span></td>");
-            os_sprintf(temp_str, format_str, "ssid", config.ssid);
-            strcpy(&_config_page_html[os_strlen(_config_page_html)],temp_str);
-            strcpy(&_config_page_html[os_strlen(_config_page_html)], "</tr>");
-
-            strcpy(&_config_page_html[os_strlen(_config_page_html)], "<tr>"
-                                                                        "<td style=\"background-color: rgb(0, 0, 0); text-align: left; vertical-align: middle;\">"
-                                                                        "<span style=\"color:#FFFFFF;\">SSID</span></td>");
-            os_sprintf(temp_str, format_str, "password", config.password);
-            strcpy(&_config_page_html[os_strlen(_config_page_html)],temp_str);
-            strcpy(&_config_page_html[os_strlen(_config_page_html)], "</tr>");
+            os_printf("ESP8266 : SSID FRAMEWORK : Roamed to %02X:%02X:%02X:%02X:%02X:%02X\n",
+                        _roam_current_bssid[0], _roam_current_bssid[1], _roam_current_bssid[2],
+                        _roam_current_bssid[3], _roam_current_bssid[4], _roam_current_bssid[5]);
         }
-        else
+        _roam_in_progress = 0;
+        _roam_rssi_valid = 0;
+        _roam_dwell_ms = 0;
+    }
+#endif
+}
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_ip_apply(uint8_t mode, struct ip_info* static_ip, ip_addr_t* static_dns, uint8_t* ssid)
+{
+    //SET UP THE STATION IP CONFIGURATION BEFORE A CONNECT ATTEMPT
+    //AND START THE TIME TO IP MEASUREMENT
+
+    os_timer_disarm(&_ip_lease_verify_timer);
+    _ip_connect_mode = mode;
+    _ip_lease_verifying = 0;
+    _ip_lease_reused = 0;
+    _ip_timing = 1;
+    _ip_connect_start_us = system_get_time();
+
+    if(mode == ESP8266_SSID_FRAMEWORK_IP_MODE_STATIC)
+    {
+        wifi_station_dhcpc_stop();
+        wifi_set_ip_info(STATION_IF, static_ip);
+        if(static_dns->addr != 0)
         {
-            //NO SAVED WIFI CREDENTIALS PRESENT
-            strcpy(&_config_page_html[os_strlen(_config_page_html)], "<tr>"
-                                                                        "<td style=\"background-color: rgb(0, 0, 0); text-align: left; vertical-align: middle;\">"
-                                                                        "<span style=\"color:#FFFFFF;\">SSID</span></td>"
-                                                                        "<td><input name=\"ssid\" type=\"text\" /></td>"
-                                                                        "</tr>"
-                                                                        "<tr>"
-                                                                        "<td style=\"background-color: rgb(0, 0, 0);\"><span style=\"color:#FFFFFF;\">PASSWORD</span></td>"
-                                                                        "<td><input name=\"password\" type=\"text\"/></td>"
-                                                                        "</tr>");
-        }
-
-        os_free(temp_str);
-        strcpy(&_config_page_html[os_strlen(_config_page_html)],"<tr>"
-                                                                "<td colspan=\"2\" style=\"background-color: rgb(255, 204, 51);\">"
-                                                                "<span style=\"font-size:18px;\"><strong>Additional Configuration</strong></span></td>"
-                                                                "</tr>");
-
-        //ADD CUSTOM CONFIG FIELDS IF ANY
-        if(_custom_user_field_group != NULL &&_custom_user_field_group->custom_fields_count != 0)
-        {
-            //USER CUSTOM FIELDS PRESENT
-            uint8_t i = 0;
-            char* row_line = (char*)os_zalloc(200);
-            const char* row_format_string = "<span style=\"color:#FFFFFF;\">%s</span></td><td><input type=\"text\" name=\"%s\"></td>";
-            while(i < _custom_user_field_group->custom_fields_count)
-            {
-                os_sprintf(row_line, row_format_string,
-                                    (_custom_user_field_group->custom_fields + i)->custom_field_label,
-                                    (_custom_user_field_group->custom_fields + i)->custom_field_name);
-                strcpy(&_config_page_html[os_strlen(_config_page_html)], "<tr><td style=\"background-color: rgb(0, 0, 0); text-align: left; vertical-align: middle;\">");
-                strcpy(&_config_page_html[os_strlen(_config_page_html)], row_line);
-                strcpy(&_config_page_html[os_strlen(_config_page_html)],"</tr>");
-                i++;
-            }
-            os_free(row_line);
-        }
-
-        //ADD MORE HTML
-        strcpy(&_config_page_html[os_strlen(_config_page_html)], "<tr>"
-                                                                    "<td colspan=\"2\" style=\"text-align: right; vertical-align: middle;\">"
-                                                                    "<input type=\"submit\" value=\"   Save   \" />"
-                                                                    "</td>"
-                                                                    "</tr>"
-                                                                    "<tr>"
-                                                                    "<td colspan=\"2\" style=\"background-color: rgb(255, 204, 51);\"><span style=\"font-size:18px;\"><strong>System Params</strong></span>"
-                                                                    "<ul>");
-
-        //ADD SYSTEM PARAMS SECTION
-        temp_str = (char*)os_zalloc(50);
-        uint8_t mac[6];
-        os_sprintf(temp_str, "<li>CPU Frequency : %dMHz</li>", ESP8266_SYSINFO_GetCpuFrequency());
-        strcpy(&_config_page_html[os_strlen(_config_page_html)], temp_str);
-        
-        os_sprintf(temp_str, "<li>ESP8266 Chip ID : %x</li>", mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
-        strcpy(&_config_page_html[os_strlen(_config_page_html)], temp_str);
-
-        ESP8266_SYSINFO_GetSystemMac(mac);
-        os_sprintf(temp_str, "<li>MAC Address : %02X:%02X:%02X:%02X:%02X:%02X</li>", mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
-        strcpy(&_config_page_html[os_strlen(_config_page_html)], temp_str);
-
-        os_sprintf(temp_str, "<li>Flash Chip ID : 0x%X</li>", ESP8266_SYSINFO_GetFlashChipId());
-        strcpy(&_config_page_html[os_strlen(_config_page_html)], temp_str);
-
-        uint8_t map = ESP8266_SYSINFO_GetSystemFlashMap();
-        switch(map)
-        {
-            case FLASH_SIZE_4M_MAP_256_256:
-                    strcpy(&_config_page_html[os_strlen(_config_page_html)], "<li>Flash size : 4Mbits. Map : 256KBytes + 256KBytes</li>");
-                    break;
-            case FLASH_SIZE_2M:
-                    strcpy(&_config_page_html[os_strlen(_config_page_html)], "<li>Flash size : 2Mbits. Map : 256KBytes</li>");
-                    break;
-            case FLASH_SIZE_8M_MAP_512_512:
-                    strcpy(&_config_page_html[os_strlen(_config_page_html)], "<li>Flash size : 8Mbits. Map : 512KBytes + 512KBytes</li>");
-                    break;
-            case FLASH_SIZE_16M_MAP_512_512:
-                    strcpy(&_config_page_html[os_strlen(_config_page_html)], "<li>Flash size : 16Mbits. Map : 512KBytes + 512KBytes</li>");
-                    break;
-            case FLASH_SIZE_32M_MAP_512_512:
-                    strcpy(&_config_page_html[os_strlen(_config_page_html)], "<li>Flash size : 32Mbits. Map : 512KBytes + 512KBytes</li>");
-                    break;
-            case FLASH_SIZE_16M_MAP_1024_1024:
-                    strcpy(&_config_page_html[os_strlen(_config_page_html)], "<li>Flash size : 16Mbits. Map : 1024KBytes + 1024KBytes</li>");
-                    break;
-            case FLASH_SIZE_32M_MAP_1024_1024:
-                    strcpy(&_config_page_html[os_strlen(_config_page_html)], "<li>Flash size : 32Mbits. Map : 1024KBytes + 1024KBytes</li>");
-                    break;
-            /*case FLASH_SIZE_32M_MAP_2048_2048:
-                    strcpy(&_config_page_html[os_strlen(_config_page_html)], "<li>Flash size : 32Mbits. Map : 2048KBytes + 2048KBytes (Not Supported)</li>");
-                    break;*
-            case FLASH_SIZE_64M_MAP_1024_1024:
-                    strcpy(&_config_page_html[os_strlen(_config_page_html)], "<li>Flash size : 64Mbits. Map : 1024KBytes + 1024KBytes</li>");
-                    break;
-            case FLASH_SIZE_128M_MAP_1024_1024:
-                    strcpy(&_config_page_html[os_strlen(_config_page_html)], "<li>Flash size : 128Mbits. Map : 1024KBytes + 1024KBytes</li>");
-                    break;*/
+            espconn_dns_setserver(0, static_dns);
         }
-        
-        uint8_t flashmode = ESP8266_SYSINFO_GetFlashChipMode();
-        switch(flashmode)
+        return;
+    }
+
+    if(mode == ESP8266_SSID_FRAMEWORK_IP_MODE_LEASE_REUSE && _param_record.lease.ip.addr != 0 &&
+        os_strncmp((char*)_param_record.lease_ssid, (char*)ssid, ESP8266_SSID_FRAMEWORK_SSID_NAME_LEN) == 0)
+    {
+        //LAST LEASE WAS FOR THIS SSID. USE IT WITHOUT ASKING DHCP
+        wifi_station_dhcpc_stop();
+        wifi_set_ip_info(STATION_IF, &_param_record.lease);
+        if(_param_record.lease_dns.addr != 0)
         {
-            case 0:
-                strcpy(&_config_page_html[os_strlen(_config_page_html)], "<li>Flash Mode : QIO</li>");
-                break;
-            case 1:
-                strcpy(&_config_page_html[os_strlen(_config_page_html)], "<li>Flash Mode : QOUT</li>");
-                break;
-            case 2:
-                strcpy(&_config_page_html[os_strlen(_config_page_html)], "<li>Flash Mode : DIO</li>");
-                break;
-            case 3:
-                strcpy(&_config_page_html[os_strlen(_config_page_html)], "<li>Flash Mode : DOUT</li>");
-                break;
-            default:
-                strcpy(&_config_page_html[os_strlen(_config_page_html)], "<li>Flash Mode : UNKNOWN</li>");
-                break;
+            espconn_dns_setserver(0, &_param_record.lease_dns);
         }
+        _ip_lease_verifying = 1;
+        return;
+    }
+
+    //DHCP (ALSO LEASE REUSE WITHOUT A USABLE LEASE)
+    wifi_station_dhcpc_start();
+}
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_ip_lease_verify_start(void)
+{
+    //PROBE THE REUSED ADDRESS : LEASE PROBE COUNT ARP REQUESTS FOR IT, ARP WAIT
+    //APART. ANY HOST ALREADY USING THE ADDRESS ANSWERS AND LWIP KEEPS ITS REPLY
+    //IN THE ARP TABLE. THE LEASE IS ONLY TRUSTED IF NO PROBE IS ANSWERED
+    //NOTE : THE PROBES CARRY OUR ADDRESS AS SENDER, NOT 0.0.0.0 (RFC 5227). LWIP
+    //ONLY RECORDS REPLIES ADDRESSED TO ITS OWN IP, SO A 0.0.0.0 PROBE COULD NOT
+    //SEE THE ANSWER. A SINGLE LOST PROBE OR REPLY IS COVERED BY THE REPEATS
+
+    struct ip_info info;
 
-        os_sprintf(temp_str, "<li>SDK Version : %s</li>", ESP8266_SYSINFO_GetSDKVersion());
-        strcpy(&_config_page_html[os_strlen(_config_page_html)], temp_str);
+    wifi_get_ip_info(STATION_IF, &info);
+    if(_esp8266_ssid_framework_debug)
+    {
+        os_printf("ESP8266 : SSID FRAMEWORK : Checking reused lease " IPSTR "\n", IP2STR(&info.ip));
+    }
+
+    _ip_lease_probes = 0;
+    _esp8266_ssid_framework_ip_lease_verify_timer_cb(NULL);
+}
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_ip_lease_verify_timer_cb(void* pArg)
+{
+    //LEASE CHECK TIMER CB FUNCTION
+    //AN ARP ENTRY FOR OUR OWN ADDRESS MEANS ANOTHER HOST ANSWERED. OTHERWISE
+    //SEND THE NEXT PROBE, OR TRUST THE LEASE ONCE ALL PROBES WENT UNANSWERED
 
-        os_free(temp_str);
+    struct ip_info info;
+    struct netif* netif;
+    struct eth_addr* eth_ret;
+    ip_addr_t* ip_ret;
 
-        //ADD ENDING HTML
-        strcpy(&_config_page_html[os_strlen(_config_page_html)], "</ul>"
-                                                                    "</td>"
-                                                                    "</tr>"
-                                                                    "</tbody>"
-                                                                    "</table>"
-                                                                    "</form>"
-                                                                    "</body>"
-                                                                    "</html>");
+    if(!_ip_lease_verifying)
+    {
+        return;
+    }
 
-        config_path.path_response = _config_page_html;
-        ESP8266_TCP_SERVER_RegisterUrlPathCb(config_path);
+    wifi_get_ip_info(STATION_IF, &info);
+    netif = _esp8266_ssid_framework_netif_by_ip(&info.ip);
+    if(netif == NULL)
+    {
+        //ADDRESS NOT ON ANY INTERFACE. NOTHING TO PROBE WITH
+        _ip_lease_verifying = 0;
+        wifi_station_dhcpc_start();
+        return;
+    }
 
-        ESP8266_TCP_SERVER_Start();
+    if(_ip_lease_probes != 0 && etharp_find_addr(netif, &info.ip, &eth_ret, &ip_ret) >= 0)
+    {
+        //ADDRESS CONFLICT. FORGET THE LEASE AND FALL BACK TO DHCP
+        if(_esp8266_ssid_framework_debug)
+        {
+            os_printf("ESP8266 : SSID FRAMEWORK : Reused lease in use by another host. Using DHCP\n");
+        }
+        _ip_lease_verifying = 0;
+        _param_record.lease.ip.addr = 0;
+        _esp8266_ssid_framework_param_save();
+        wifi_station_dhcpc_start();
+        return;
+    }
 
-        //START MDNS(SOFTAP MODE)
-        ESP8266_MDNS_SetDebug(_esp8266_ssid_framework_debug);
-        ESP8266_MDNS_Initialize("esp8266", "esp8266", 80, 1);
+    if(_ip_lease_probes < ESP8266_SSID_FRAMEWORK_LEASE_PROBE_COUNT)
+    {
+        _ip_lease_probes++;
+        etharp_request(netif, &info.ip);
+        os_timer_disarm(&_ip_lease_verify_timer);
+        os_timer_arm(&_ip_lease_verify_timer, ESP8266_SSID_FRAMEWORK_LEASE_ARP_WAIT_MS, 0);
+        return;
     }
+
+    _ip_lease_verifying = 0;
+    _ip_lease_reused = 1;
+    _esp8266_ssid_framework_wifi_got_ip();
 }
 
-void ICACHE_FLASH_ATTR _esp8266_ssid_framework_wifi_start_connection_process(struct station_config* sconfig)
+#if ESP8266_SSID_FRAMEWORK_MODULE_STATION_MDNS
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_mdns_start(void)
 {
-    //START WIFI CONNECTION PROCESS
-    //IF CONNECTION FAILS AFTER CONFIGURED NUMBER OF TIMES, SSID CONFIGURAION STARTS
+    //START THE STATION MODE MDNS RESPONDER FOR THE CURRENT IP
+    //TXT RECORDS = PROJECT NAME + NON EMPTY CUSTOM FIELD VALUES
 
-    struct station_config config;
+    struct ip_info info;
+    uint8_t count = 0;
+    uint8_t i;
 
-    _esp8266_ssid_framework_wifi_connected = 0;
-    _ssid_connect_retry_count = 1;
+    _esp8266_ssid_framework_mdns_stop();
+    wifi_get_ip_info(STATION_IF, &info);
 
-    wifi_set_opmode(STATION_MODE);
-    os_delay_us(100);
-    wifi_station_set_auto_connect(FALSE);
-    wifi_station_set_reconnect_policy(FALSE);
+    os_memset(&_mdns_info, 0, sizeof(struct mdns_info));
+    _mdns_info.host_name = _mdns_hostname;
+    _mdns_info.server_name = ESP8266_SSID_FRAMEWORK_MDNS_SERVICE;
+    _mdns_info.server_port = ESP8266_SSID_FRAMEWORK_MDNS_PORT;
+    _mdns_info.ipAddr = info.ip.addr;
 
-    switch(_input_mode)
+    if(_project_name != NULL)
     {
-        case ESP8266_SSID_FRAMEWORK_SSID_INPUT_GPIO:
-        case ESP8266_SSID_FRAMEWORK_SSID_INPUT_INTERNAL:
-            //DO NOTHING. SIMPLY ATTEMPT TO CONNECT TO WIFI
-            break;
-
-        case ESP8266_SSID_FRAMEWORK_SSID_INPUT_HARDCODED:
-            //CHECK IF ESP8266 HAS VALID INTERNAL STORED WIFI CREDENTIALS
-            //IF PRESENT, USE THOSE TO ATTEMPT TO CONNECT TO WIFI
-            //IF NOT PRESENT, USE THE HARDCODED SSID DATA
-            wifi_station_get_config_default(&config);
-            if(_esp8266_ssid_framework_check_valid_stationconfig(&config))
-            {
-                //USE INTERNAL CREDENTIALS
-                //SO DO NOTHING
-                os_printf("internal saved ssid valid. Using that\n");
-                os_printf("%s\n",config.ssid);
-                os_printf("%s\n",config.password);
-            }
-            else
+        _esp8266_ssid_framework_mdns_txt_set(count, "project", _project_name);
+        _mdns_info.txt_data[count] = _mdns_txt[count];
+        count++;
+    }
+    if(_custom_user_field_group != NULL)
+    {
+        for(i = 0; i < _custom_user_field_group->custom_fields_count; i++)
+        {
+            if(_user_data_values[i][0] != '\0')
             {
-                os_printf("internal saved ssid invalid. using hardcoded ssid\n");
-                os_printf("%s\n",_ssid_hardcoded_name_pwd.ssid_name);
-                os_printf("%s\n",_ssid_hardcoded_name_pwd.ssid_pwd);
-                //USE HARDCODED CREDENTIALS
-                os_memset(config.ssid, 0, ESP8266_SSID_FRAMEWORK_SSID_NAME_LEN);
-                os_memset(config.password, 0, ESP8266_SSID_FRAMEWORK_SSID_PSWD_LEN);
-                os_memcpy(&config.ssid, _ssid_hardcoded_name_pwd.ssid_name, strlen(_ssid_hardcoded_name_pwd.ssid_name));
-                os_memcpy(&config.password, _ssid_hardcoded_name_pwd.ssid_pwd, strlen(_ssid_hardcoded_name_pwd.ssid_pwd));
-                wifi_station_set_config(&config);
+                _esp8266_ssid_framework_mdns_txt_set(count, (_custom_user_field_group->custom_fields + i)->custom_field_name, _user_data_values[i]);
+                _mdns_info.txt_data[count] = _mdns_txt[count];
+                count++;
             }
-            break;
+        }
+    }
 
-        case ESP8266_SSID_FRAMEWORK_SSID_INPUT_FLASH:
-            //READ SSID/PSWD FROM SPECIFIED FLASH ADDRESS
-            //USE THOSE TO ATTEMPT TO CONNECT TO SSID
-            break;
+    espconn_mdns_init(&_mdns_info);
+    _mdns_running = 1;
 
-        case ESP8266_SSID_FRAMEWORK_SSID_INPUT_EEPROM:
-            //READ SSID/PSWD FROM SPECIFIED EEPROM ADDRESS
-            //USE THOSE TO ATTEMPT TO CONNECT TO SSID
-            break;
+    if(_esp8266_ssid_framework_debug)
+    {
+        os_printf("ESP8266 : SSID FRAMEWORK : mDNS %s.local @ " IPSTR " (%u txt records)\n", _mdns_hostname, IP2STR(&info.ip), count);
     }
 
-    if(sconfig != NULL)
+    //ANNOUNCEMENT BURST SO LISTENERS PICK THE DEVICE UP WITHOUT QUERYING
+    _mdns_announce_count = 0;
+    os_timer_disarm(&_mdns_announce_timer);
+    os_timer_setfn(&_mdns_announce_timer, _esp8266_ssid_framework_mdns_announce_timer_cb, NULL);
+    os_timer_arm(&_mdns_announce_timer, ESP8266_SSID_FRAMEWORK_MDNS_ANNOUNCE_INTERVAL_MS, 1);
+}
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_mdns_stop(void)
+{
+    //CLOSE THE STATION MODE MDNS RESPONDER (IF RUNNING)
+
+    os_timer_disarm(&_mdns_announce_timer);
+    if(_mdns_running)
     {
-        wifi_station_set_config(sconfig);
-        os_printf("ssid = %s\n", sconfig->ssid);
-        os_printf("pswd = %s\n", sconfig->password);
+        espconn_mdns_close();
+        _mdns_running = 0;
     }
+}
 
-    wifi_station_connect();
-    wifi_station_dhcpc_start();
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_mdns_announce_timer_cb(void* pArg)
+{
+    //MDNS ANNOUNCEMENT TIMER CB FUNCTION
+    //RE-REGISTERING THE SERVICE MAKES THE SDK SEND AN UNSOLICITED ANNOUNCEMENT
 
-    //SETUP WIFI CONNECTION TIMER
-    os_timer_setfn(&_wifi_connect_timer, _esp8266_ssid_framework_wifi_connect_timer_cb, sconfig);
-    os_timer_arm(&_wifi_connect_timer, _ssid_connect_retry_delay_ms, 0);
+    if(!_mdns_running || _mdns_announce_count >= ESP8266_SSID_FRAMEWORK_MDNS_ANNOUNCE_COUNT)
+    {
+        os_timer_disarm(&_mdns_announce_timer);
+        return;
+    }
+
+    _mdns_announce_count++;
+    espconn_mdns_server_unregister();
+    espconn_mdns_server_register();
 }
+#endif
 
-void ICACHE_FLASH_ATTR _esp8266_ssid_framework_wifi_start_softap(void)
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_param_load(void)
 {
-    //START SOFTAP ON ESP8266
-    //SSID = ESP8266 | PASSWORD = 123456789
+    //LOAD THE FRAMEWORK PARAMETER RECORD FROM FLASH (ONCE)
+    //DEFAULTS IF NOTHING (OR AN OLDER LAYOUT) IS STORED
 
-    struct softap_config config;
+    if(_param_record_loaded)
+    {
+        return;
+    }
+    _param_record_loaded = 1;
 
-    wifi_set_opmode(SOFTAP_MODE);
+    _param_sector = _esp8266_ssid_framework_param_sector();
+    if(_param_sector == 0)
+    {
+        //NOT DEBUG ONLY : NOTHING THE FRAMEWORK LEARNS SURVIVES A REBOOT
+        os_printf("ESP8266 : SSID FRAMEWORK : No safe flash sector for parameters (map %u). Parameters are not stored!\n",
+                    ESP8266_SYSINFO_GetSystemFlashMap());
+    }
 
-    wifi_softap_get_config(&config);
-    os_memset(config.ssid, 0, ESP8266_SSID_FRAMEWORK_SSID_NAME_LEN);
-    os_memset(config.password, 0, ESP8266_SSID_FRAMEWORK_SSID_PSWD_LEN);
-    os_memcpy(config.ssid, "ESP8266", 7);
-    os_memcpy(config.password, "12345678", 8);
-    config.authmode = AUTH_WEP;
-    config.ssid_hidden = 0;
-    config.max_connection = 2;
-    wifi_softap_set_config_current(&config);
+    if(_param_sector == 0 ||
+        !system_param_load(_param_sector, 0, &_param_record, sizeof(ESP8266_SSID_FRAMEWORK_PARAM_RECORD)) ||
+        _param_record.magic != ESP8266_SSID_FRAMEWORK_PARAM_MAGIC ||
+        _param_record.version == 0 || _param_record.version > ESP8266_SSID_FRAMEWORK_PARAM_VERSION)
+    {
+        if(_esp8266_ssid_framework_debug)
+        {
+            os_printf("ESP8266 : SSID FRAMEWORK : No saved parameters. Using defaults\n");
+        }
+        os_memset(&_param_record, 0, sizeof(ESP8266_SSID_FRAMEWORK_PARAM_RECORD));
+        _param_record.ip_mode = ESP8266_SSID_FRAMEWORK_IP_MODE_DHCP;
+    }
+    else
+    {
+        //OLDER RECORDS END BEFORE THE NEWER PARTS. KEEP WHAT THEY HAVE
+        if(_param_record.version < 2)
+        {
+            _param_record.custom_signature = 0;
+            _param_record.custom_present = 0;
+            os_memset(_param_record.custom_values, 0, ESP8266_SSID_FRAMEWORK_CUSTOM_FIELD_STORE_LEN);
+        }
+        if(_param_record.version < 3)
+        {
+            os_memset(&_param_record.stats, 0, sizeof(ESP8266_SSID_FRAMEWORK_STATS));
+        }
+        if(_param_record.version < 4)
+        {
+            os_memset(&_param_record.credential, 0, sizeof(ESP8266_SSID_FRAMEWORK_CREDENTIAL_RECORD));
+        }
+    }
 }
 
-void ICACHE_FLASH_ATTR _esp8266_ssid_framework_tcp_server_path_config_cb(void)
+uint8_t ICACHE_FLASH_ATTR _esp8266_ssid_framework_param_save(void)
 {
-    //CB FUNCTION FOR CONFIG PATH FOUND IN TCP SERVER REQUESTS
+    //SAVE THE FRAMEWORK PARAMETER RECORD TO FLASH
+    //RETURN 0 IF IT IS NOT STORED (NO PARAMETER SECTOR OR THE WRITE FAILED)
+
+    _param_record.magic = ESP8266_SSID_FRAMEWORK_PARAM_MAGIC;
+    _param_record.version = ESP8266_SSID_FRAMEWORK_PARAM_VERSION;
+
+    if(_param_sector == 0 ||
+        !system_param_save_with_protect(_param_sector, &_param_record, sizeof(ESP8266_SSID_FRAMEWORK_PARAM_RECORD)))
+    {
+        if(_esp8266_ssid_framework_debug)
+        {
+            os_printf("ESP8266 : SSID FRAMEWORK : Parameter save failed!\n");
+        }
+        return 0;
+    }
+#if ESP8266_SSID_FRAMEWORK_MODULE_STATS
+    _stats_dirty = 0;
+#endif
+    return 1;
+}
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_CREDENTIAL_CRYPT
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_credential_keys(void)
+{
+    //DERIVE THE CIPHER AND MAC KEYS (ONCE). THE BUILD SECRET IS HASHED INTO A
+    //128 BIT SIPHASH KEY (TWO SIPHASHES UNDER FIXED KEYS THAT DIFFER ONLY IN
+    //THE LAST WORD), EVERY 64 BIT KEY WORD IS SIPHASH(SECRET KEY, CHIP ID + INDEX)
+
+    const char* secret = ESP8266_SSID_FRAMEWORK_CREDENTIAL_SECRET;
+    //"ESP8266 SSID FW" + HALF INDEX
+    uint32_t derive_key[4] = {0x38505345, 0x20363632, 0x44495353, 0x00574620};
+    uint32_t secret_key[4];
+    uint32_t input[2];
+    uint16_t i;
+
+    if(_credential_keys_ready)
+    {
+        return;
+    }
+
+    for(i = 0; i < 2; i++)
+    {
+        derive_key[3] = (derive_key[3] & 0x00FFFFFF) | ((uint32_t)i << 24);
+        _esp8266_ssid_framework_siphash24(derive_key, (const uint8_t*)secret, os_strlen(secret), (uint8_t*)&secret_key[i * 2]);
+    }
+
+    input[0] = system_get_chip_id();
+    for(i = 0; i < 6; i++)
+    {
+        input[1] = i;
+        _esp8266_ssid_framework_siphash24(secret_key, (uint8_t*)input, sizeof(input), (uint8_t*)&_credential_key[i * 2]);
+    }
+    os_memset(secret_key, 0, sizeof(secret_key));
+    _credential_keys_ready = 1;
+}
+
+uint8_t ICACHE_FLASH_ATTR _esp8266_ssid_framework_credential_store(struct station_config* config)
+{
+    //ENCRYPT STATION CREDENTIALS INTO THE PARAMETER RECORD (NOT SAVED HERE)
+    //A NEW COUNTER (NONCE) FOR EVERY STORE. RETURN 1 IF THEY CHANGED
+
+    ESP8266_SSID_FRAMEWORK_CREDENTIAL_RECORD* record = &_param_record.credential;
+    struct station_config current;
+
+    if(_esp8266_ssid_framework_credential_load(&current) &&
+        os_memcmp(current.ssid, config->ssid, ESP8266_SSID_FRAMEWORK_SSID_NAME_LEN) == 0 &&
+        os_memcmp(current.password, config->password, ESP8266_SSID_FRAMEWORK_SSID_PSWD_LEN) == 0)
+    {
+        os_memset(&current, 0, sizeof(struct station_config));
+        return 0;
+    }
+    os_memset(&current, 0, sizeof(struct station_config));
+
+    _esp8266_ssid_framework_credential_keys();
+    record->counter++;
+    record->present = 1;
+    os_memcpy(record->data, config->ssid, ESP8266_SSID_FRAMEWORK_SSID_NAME_LEN);
+    os_memcpy(&record->data[ESP8266_SSID_FRAMEWORK_SSID_NAME_LEN], config->password, ESP8266_SSID_FRAMEWORK_SSID_PSWD_LEN);
+    _esp8266_ssid_framework_chacha20_xor(_credential_key, record->counter, system_get_chip_id(), record->data, ESP8266_SSID_FRAMEWORK_CREDENTIAL_LEN);
+    _esp8266_ssid_framework_siphash24(&_credential_key[8], (uint8_t*)record,
+                                        sizeof(ESP8266_SSID_FRAMEWORK_CREDENTIAL_RECORD) - ESP8266_SSID_FRAMEWORK_CREDENTIAL_MAC_LEN, record->mac);
+    return 1;
+}
+
+uint8_t ICACHE_FLASH_ATTR _esp8266_ssid_framework_credential_load(struct station_config* config)
+{
+    //DECRYPT THE STORED STATION CREDENTIALS INTO config (ZEROED IF NONE)
+    //RETURN 0 IF NONE ARE STORED OR THE MAC CHECK FAILS (OTHER CHIP, OTHER
+    //BUILD SECRET OR A DAMAGED RECORD)
+
+    ESP8266_SSID_FRAMEWORK_CREDENTIAL_RECORD* record = &_param_record.credential;
+    uint8_t mac[ESP8266_SSID_FRAMEWORK_CREDENTIAL_MAC_LEN];
+    uint8_t data[ESP8266_SSID_FRAMEWORK_CREDENTIAL_LEN];
+    uint32_t start_us = system_get_time();
+
+    os_memset(config, 0, sizeof(struct station_config));
+    _esp8266_ssid_framework_param_load();
+    if(!record->present)
+    {
+        return 0;
+    }
+
+    _esp8266_ssid_framework_credential_keys();
+    _esp8266_ssid_framework_siphash24(&_credential_key[8], (uint8_t*)record,
+                                        sizeof(ESP8266_SSID_FRAMEWORK_CREDENTIAL_RECORD) - ESP8266_SSID_FRAMEWORK_CREDENTIAL_MAC_LEN, mac);
+    if(os_memcmp(mac, record->mac, ESP8266_SSID_FRAMEWORK_CREDENTIAL_MAC_LEN) != 0)
+    {
+        if(_esp8266_ssid_framework_debug)
+        {
+            os_printf("ESP8266 : SSID FRAMEWORK : Stored credentials failed the MAC check!\n");
+        }
+        return 0;
+    }
+
+    os_memcpy(data, record->data, ESP8266_SSID_FRAMEWORK_CREDENTIAL_LEN);
+    _esp8266_ssid_framework_chacha20_xor(_credential_key, record->counter, system_get_chip_id(), data, ESP8266_SSID_FRAMEWORK_CREDENTIAL_LEN);
+    os_memcpy(config->ssid, data, ESP8266_SSID_FRAMEWORK_SSID_NAME_LEN);
+    os_memcpy(config->password, &data[ESP8266_SSID_FRAMEWORK_SSID_NAME_LEN], ESP8266_SSID_FRAMEWORK_SSID_PSWD_LEN);
+    os_memset(data, 0, ESP8266_SSID_FRAMEWORK_CREDENTIAL_LEN);
 
+    _credential_decrypt_us = system_get_time() - start_us;
     if(_esp8266_ssid_framework_debug)
     {
-        os_printf("ESP8266 : SSID FRAMEWORK : Config path found!!\n");
+        os_printf("ESP8266 : SSID FRAMEWORK : Credentials decrypted in %u us\n", _credential_decrypt_us);
     }
+    return 1;
 }
 
-void ICACHE_FLASH_ATTR _esp8266_ssid_framework_tcp_server_post_data_cb(char* data, uint16_t len, uint8_t post_flag)
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_credential_migrate(void)
 {
-    //CB FUNCTION FOR TCP SERVER FOR TCP DATA RECEIVED
-    //POST FLAG = 1 : POST DATA
-    //POST FLAG = 0 : GET DATA (IGNORE : PATH CB WILL HANDLE IT)
+    //MOVE CREDENTIALS THE SDK CACHED IN PLAINTEXT (OLDER FIRMWARE) INTO THE
+    //ENCRYPTED RECORD AND WIPE THE SDK COPY. NOTHING TO DO ONCE IT IS EMPTY
+    //THE SDK COPY IS ONLY WIPED ONCE A RECORD THAT DECRYPTS IS IN FLASH. A
+    //GOOD RECORD IS NEWER THAN THE SDK COPY (ONLY THIS FIRMWARE WRITES IT),
+    //A MISSING OR DAMAGED ONE IS REPLACED, WRITTEN AND READ BACK FIRST
 
-    if(post_flag)
+    struct station_config config;
+    struct station_config stored;
+    ESP8266_SSID_FRAMEWORK_CREDENTIAL_RECORD saved;
+
+    wifi_station_get_config_default(&config);
+    if(!_esp8266_ssid_framework_check_valid_stationconfig(&config))
     {
-      if(_esp8266_ssid_framework_debug)
-      {
-          os_printf("ESP8266 : SSID FRAMEWORK : SSID configuration data received!\n");
-      }
-
-      //EXTRACT SSID NAME / PASSWORD / CUSTOM FIELDS (IF ANY)
-      char* ssid_name = (char*)os_zalloc(ESP8266_SSID_FRAMEWORK_SSID_NAME_LEN);
-      char* ssid_pswd = (char*)os_zalloc(ESP8266_SSID_FRAMEWORK_SSID_PSWD_LEN);
-      char* user_ptrs[ESP8266_SSID_FRAMEWORK_CUSTOM_FIELD_MAX_COUNT];
-
-      char* config_str = strstr(data, "ssid=");
-      char* ptr1 = strtok(config_str, "&");
-      char* ptr2 = strtok(NULL, "&");
-
-      uint8_t i = 0;
-      if(_custom_user_field_group != NULL)
-      {
-          while (i < _custom_user_field_group->custom_fields_count)
-          {
-              user_ptrs[i] = strtok(NULL, "&");
-              i++;
-          }
-      }
-
-      //EXTRACT SSID / PSWD
-      strtok(ptr1, "=");
-      char* ssid = strtok(NULL, "=");
-
-      strtok(ptr2, "=");
-      char* pswd = strtok(NULL, "=");
-
-      //EXTRACT CUSTOM FIELDS DATA
-      i = 0;
-      if(_custom_user_field_group != NULL)
-      {
-          while (i < _custom_user_field_group->custom_fields_count)
-          {
-              strtok(user_ptrs[i], "=");
-              _user_data_ptrs[i] = strtok(NULL, "=");
-              i++;
-          }
-      }
-
-      strncpy(ssid_name, ssid, ESP8266_SSID_FRAMEWORK_SSID_NAME_LEN);
-      strncpy(ssid_pswd, pswd, ESP8266_SSID_FRAMEWORK_SSID_PSWD_LEN);
-
-      if(strcmp(ssid_name, "") == 0 || strcmp(ssid_pswd, "") == 0)
-      {
-          //EITHER THE SSID OR PASSWORD EMPTY
-          os_printf("ESP8266 : SSID FRAMEWORK : Either ssid or password empty\n");
-          return;
-      }
-
-      os_printf("ESP8266 : SSID FRAMEWORK : SSID name : %s\n", ssid_name);
-      os_printf("ESP8266 : SSID FRAMEWORK : SSID passsword : %s\n", ssid_pswd);
-      os_printf("ESP8266 : SSID FRAMEWORK : Connecting to SSID ...\n", ssid_pswd);
-
-      //DEPENDING ON INPUT MODE, SAVE THE CREDENTIALS
-      if(_input_mode == ESP8266_SSID_FRAMEWORK_SSID_INPUT_HARDCODED ||
-          _input_mode == ESP8266_SSID_FRAMEWORK_SSID_INPUT_GPIO ||
-          _input_mode == ESP8266_SSID_FRAMEWORK_SSID_INPUT_INTERNAL)
-      {
-          //NO NEED TO SAVE, JUST RESTART WIFI CONNECTION PROCESS WITH NEW CREDENTIALS
-          //LET THE ESP8266 CACHE THE CREDENTIALS INTERNALLY
-          struct station_config config;
-          os_memset(config.ssid, 0, ESP8266_SSID_FRAMEWORK_SSID_NAME_LEN);
-          os_memset(config.password, 0, ESP8266_SSID_FRAMEWORK_SSID_PSWD_LEN);
-          os_memcpy(&config.ssid, ssid_name, ESP8266_SSID_FRAMEWORK_SSID_NAME_LEN);
-          os_memcpy(&config.password, ssid_pswd, ESP8266_SSID_FRAMEWORK_SSID_PSWD_LEN);
-
-          //STOP MDNS
-          ESP8266_MDNS_Stop();
-
-          //STOP TCP SERVER
-          ESP8266_TCP_SERVER_Stop();
-
-          //FREE MEMORY
-		  os_free(_config_page_html);
-
-          //START WIFI CONNECTION ATTEMPT
-          wifi_softap_dhcps_stop();
-          _esp8266_ssid_framework_wifi_start_connection_process(&config);
-
-          os_free(ssid_name);
-          os_free(ssid_pswd);
-      }
-      else if(_input_mode == ESP8266_SSID_FRAMEWORK_SSID_INPUT_FLASH)
-      {
-          //SAVE CREDENTILS IN FLASH LOCATION
-      }
-      else if(_input_mode == ESP8266_SSID_FRAMEWORK_SSID_INPUT_EEPROM)
-      {
-          //SAVE CREDENTIALS IN EEPROM LOCATION
-      }
+        return;
+    }
+
+    if(_esp8266_ssid_framework_debug)
+    {
+        os_printf("ESP8266 : SSID FRAMEWORK : Encrypting credentials cached by the SDK\n");
     }
+    if(!_esp8266_ssid_framework_credential_load(&stored))
+    {
+        _esp8266_ssid_framework_credential_store(&config);
+
+        //READ THE RECORD BACK FROM FLASH AND CHECK IT AGAINST WHAT WAS WRITTEN
+        if(!_esp8266_ssid_framework_param_save() ||
+            !system_param_load(_param_sector, (uint8_t*)&_param_record.credential - (uint8_t*)&_param_record,
+                                &saved, sizeof(ESP8266_SSID_FRAMEWORK_CREDENTIAL_RECORD)) ||
+            os_memcmp(&saved, &_param_record.credential, sizeof(ESP8266_SSID_FRAMEWORK_CREDENTIAL_RECORD)) != 0 ||
+            !_esp8266_ssid_framework_credential_load(&stored) ||
+            os_memcmp(stored.ssid, config.ssid, ESP8266_SSID_FRAMEWORK_SSID_NAME_LEN) != 0 ||
+            os_memcmp(stored.password, config.password, ESP8266_SSID_FRAMEWORK_SSID_PSWD_LEN) != 0)
+        {
+            //NOT DEBUG ONLY : THE PLAINTEXT COPY STAYS UNTIL A LATER BOOT MANAGES IT
+            os_printf("ESP8266 : SSID FRAMEWORK : Encrypted credentials not stored. SDK copy kept\n");
+            os_memset(&config, 0, sizeof(struct station_config));
+            os_memset(&stored, 0, sizeof(struct station_config));
+            return;
+        }
+    }
+
+    os_memset(&config, 0, sizeof(struct station_config));
+    os_memset(&stored, 0, sizeof(struct station_config));
+    wifi_station_set_config(&config);
 }
+#endif
 
-static bool _esp8266_ssid_framework_check_valid_stationconfig(struct station_config* config)
+#if ESP8266_SSID_FRAMEWORK_MODULE_STATS
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_stats_load(void)
 {
-    //CHECK IF PROVIDED STATION CONFIG IS VALID
+    //TAKE THE NEWER OF THE RTC COPY (RESET, DEEP SLEEP) AND THE FLASH COPY
+    //(POWER ON), COUNT THIS BOOT AND START THE FLASH FLUSH TIMER
+    //THE FIRST FLUSH IS A ONE SHOT AFTER THE EARLY FLUSH DELAY (OR THE FIRST
+    //IP), SO DEVICES POWER CYCLED MORE OFTEN THAN THE INTERVAL STILL SAVE
+    //CALLED AFTER _esp8266_ssid_framework_param_load
 
-    if(config->ssid[0] < 48 || config->ssid[0] > 126 || config->password[0] < 48 || config->password[0] > 126)
-        return false;
-    return true;
-}
\ No newline at end of file
+    if(system_rtc_mem_read(ESP8266_SSID_FRAMEWORK_STATS_RTC_BLOCK, &_stats_rtc, sizeof(ESP8266_SSID_FRAMEWORK_STATS_RTC_RECORD)) &&
+        _stats_rtc.magic == ESP8266_SSID_FRAMEWORK_STATS_RTC_MAGIC &&
+        _stats_rtc.checksum == _esp8266_ssid_framework_stats_checksum(&_stats_rtc.stats) &&
+        _stats_rtc.stats.boot_count >= _param_record.stats.boot_count)
+    {
+        os_memcpy(&_param_record.stats, &_stats_rtc.stats, sizeof(ESP8266_SSID_FRAMEWORK_STATS));
+    }
+
+    _param_record.stats.boot_count++;
+    _esp8266_ssid_framework_stats_changed();
+
+    if(_esp8266_ssid_framework_debug)
+    {
+        os_printf("ESP8266 : SSID FRAMEWORK : Boot count = %u\n", _param_record.stats.boot_count);
+    }
+
+    _stats_early_flushed = 0;
+    os_timer_setfn(&_stats_flush_timer, _esp8266_ssid_framework_stats_flush_timer_cb, NULL);
+    os_timer_arm(&_stats_flush_timer, ESP8266_SSID_FRAMEWORK_STATS_EARLY_FLUSH_MS, 0);
+}
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_stats_changed(void)
+{
+    //MIRROR THE STATS TO RTC MEMORY NOW. FLASH FOLLOWS AT THE NEXT FLUSH
+
+    _stats_rtc.magic = ESP8266_SSID_FRAMEWORK_STATS_RTC_MAGIC;
+    os_memcpy(&_stats_rtc.stats, &_param_record.stats, sizeof(ESP8266_SSID_FRAMEWORK_STATS));
+    _stats_rtc.checksum = _esp8266_ssid_framework_stats_checksum(&_stats_rtc.stats);
+    system_rtc_mem_write(ESP8266_SSID_FRAMEWORK_STATS_RTC_BLOCK, &_stats_rtc, sizeof(ESP8266_SSID_FRAMEWORK_STATS_RTC_RECORD));
+    _stats_dirty = 1;
+}
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_stats_flush_timer_cb(void* pArg)
+{
+    //STATS FLUSH TIMER CB FUNCTION
+    //SAVE THE PARAMETER RECORD ONLY IF THE STATS CHANGED SINCE THE LAST SAVE
+    //AFTER THE EARLY FLUSH THE TIMER REPEATS AT THE FLASH INTERVAL
+
+    if(!_stats_early_flushed)
+    {
+        _stats_early_flushed = 1;
+        os_timer_disarm(&_stats_flush_timer);
+        os_timer_arm(&_stats_flush_timer, ESP8266_SSID_FRAMEWORK_STATS_FLASH_INTERVAL_MS, 1);
+    }
+
+    if(!_stats_dirty)
+    {
+        return;
+    }
+    _esp8266_ssid_framework_param_save();
+}
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_stats_count_time_to_ip(uint32_t time_ms)
+{
+    //COUNT A TIME TO IP MEASUREMENT IN ITS HISTOGRAM BUCKET (SATURATING)
+
+    uint8_t bucket = 0;
+    uint32_t limit = ESP8266_SSID_FRAMEWORK_STATS_TTI_BUCKET_BASE_MS;
+
+    while(bucket < ESP8266_SSID_FRAMEWORK_STATS_TTI_BUCKET_COUNT - 1 && time_ms >= limit)
+    {
+        bucket++;
+        limit <<= 1;
+    }
+
+    if(_param_record.stats.time_to_ip[bucket] != 0xFFFF)
+    {
+        _param_record.stats.time_to_ip[bucket]++;
+        _esp8266_ssid_framework_stats_changed();
+    }
+}
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_stats_sample_rssi(void)
+{
+    //ADD THE CURRENT STATION RSSI TO THE MIN / AVG / MAX STATS
+
+    ESP8266_SSID_FRAMEWORK_STATS* stats = &_param_record.stats;
+    int8_t rssi = wifi_station_get_rssi();
+    uint16_t n;
+
+    if(rssi == 31)
+    {
+        //NO VALID READING
+        return;
+    }
+
+    if(stats->rssi_samples == 0)
+    {
+        stats->rssi_min = rssi;
+        stats->rssi_max = rssi;
+        stats->rssi_avg_x16 = rssi * 16;
+    }
+    else
+    {
+        if(rssi < stats->rssi_min)
+        {
+            stats->rssi_min = rssi;
+        }
+        if(rssi > stats->rssi_max)
+        {
+            stats->rssi_max = rssi;
+        }
+        n = (stats->rssi_samples < 255) ? (stats->rssi_samples + 1) : 256;
+        stats->rssi_avg_x16 += (rssi * 16 - stats->rssi_avg_x16) / n;
+    }
+
+    if(stats->rssi_samples != 0xFFFF)
+    {
+        stats->rssi_samples++;
+    }
+    _esp8266_ssid_framework_stats_changed();
+}
+#endif
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_custom_fields_layout(void)
+{
+    //ASSIGN EVERY CUSTOM FIELD ITS SLOT IN THE PACKED VALUE STORE
+    //THE SIGNATURE (FNV-1a OVER NAME, TYPE AND SLOT SIZE) TIES STORED VALUES TO
+    //THIS LAYOUT, SO A FIRMWARE WITH DIFFERENT FIELDS IGNORES THEM
+
+    uint8_t i;
+    uint8_t offset = 0;
+    uint32_t hash = 2166136261UL;
+    ESP8266_SSID_FRAMEWORK_CONFIG_USER_FIELD* field;
+    char* ptr;
+
+    _custom_field_signature = 0;
+    if(_custom_user_field_group == NULL || _custom_user_field_group->custom_fields_count == 0)
+    {
+        return;
+    }
+
+    for(i = 0; i < _custom_user_field_group->custom_fields_count; i++)
+    {
+        field = _custom_user_field_group->custom_fields + i;
+        _custom_field_offset[i] = offset;
+        offset += _esp8266_ssid_framework_field_size(field);
+
+        for(ptr = field->custom_field_name; *ptr != '\0'; ptr++)
+        {
+            hash = (hash ^ (uint8_t)*ptr) * 16777619UL;
+        }
+        hash = (hash ^ (uint8_t)field->custom_field_type) * 16777619UL;
+        hash = (hash ^ _esp8266_ssid_framework_field_size(field)) * 16777619UL;
+    }
+    _custom_field_signature = hash;
+}
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_custom_fields_publish(void)
+{
+    //RENDER THE STORED CUSTOM FIELD VALUES AS TEXT FOR THE WIFI CONNECTED CB
+    //(char**) AND THE MDNS TXT RECORDS. UNSET FIELDS ARE EMPTY STRINGS
+
+    uint8_t i;
+
+    if(_custom_user_field_group == NULL)
+    {
+        return;
+    }
+
+    for(i = 0; i < _custom_user_field_group->custom_fields_count; i++)
+    {
+        _esp8266_ssid_framework_field_format(i, _user_data_values[i]);
+        _user_data_ptrs[i] = _user_data_values[i];
+    }
+}
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_event_post(uint8_t type, uint8_t detail, uint8_t* mac, ip_addr_t* ip)
+{
+    //QUEUE AN EVENT RECORD AND WAKE UP THE EVENT TASK
+    //CALLED FROM SDK CALLBACKS. NO USER CODE RUNS FROM HERE
+
+    ESP8266_SSID_FRAMEWORK_EVENT* record;
+
+    _event_stats.posted++;
+    if(_event_queue_count >= ESP8266_SSID_FRAMEWORK_EVENT_QUEUE_LEN)
+    {
+        _event_stats.dropped++;
+        if(_esp8266_ssid_framework_debug)
+        {
+            os_printf("ESP8266 : SSID FRAMEWORK : Event queue full. Event %u dropped\n", type);
+        }
+        return;
+    }
+
+    record = &_event_queue[(_event_queue_head + _event_queue_count) % ESP8266_SSID_FRAMEWORK_EVENT_QUEUE_LEN];
+    os_memset(record, 0, sizeof(ESP8266_SSID_FRAMEWORK_EVENT));
+    record->type = type;
+    record->detail = detail;
+    if(mac != NULL)
+    {
+        os_memcpy(record->mac, mac, 6);
+    }
+    if(ip != NULL)
+    {
+        record->ip = *ip;
+    }
+    record->time_ms = system_get_time() / 1000;
+
+    _event_queue_count++;
+    if(_event_queue_count > _event_stats.high_water)
+    {
+        _event_stats.high_water = _event_queue_count;
+    }
+
+    _esp8266_ssid_framework_event_schedule();
+}
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_event_schedule(void)
+{
+    //GET THE EVENT TASK TO RUN : A TASK MESSAGE, OR A ZERO DELAY TIMER IF
+    //THE TASK COULD NOT BE CREATED. NOTHING BEFORE INIT
+    //ONE PENDING RUN AT A TIME. THE TASK EMPTIES THE WHOLE QUEUE
+
+    if(_event_task_posted)
+    {
+        return;
+    }
+
+    if(_event_task_ready)
+    {
+        _event_task_posted = system_os_post(ESP8266_SSID_FRAMEWORK_EVENT_TASK_PRIO, 0, 0);
+    }
+    else if(_event_timer_ready)
+    {
+        os_timer_disarm(&_event_deliver_timer);
+        os_timer_arm(&_event_deliver_timer, 0, 0);
+        _event_task_posted = 1;
+    }
+}
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_event_deliver_timer_cb(void* pArg)
+{
+    //EVENT DELIVER TIMER CB FUNCTION
+    //STANDS IN FOR THE TASK MESSAGE WHEN THE EVENT TASK IS NOT AVAILABLE
+
+    _esp8266_ssid_framework_event_task(NULL);
+}
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_event_task(os_event_t* event)
+{
+    //EVENT TASK
+    //DELIVER THE QUEUED EVENTS IN ORDER TO THE LEGACY CB FUNCTIONS AND LISTENERS
+
+    ESP8266_SSID_FRAMEWORK_EVENT record;
+    uint8_t i;
+
+    _event_task_posted = 0;
+
+    while(_event_queue_count != 0)
+    {
+        //TAKE THE RECORD OUT FIRST. LISTENERS MAY CAUSE NEW EVENTS
+        record = _event_queue[_event_queue_head];
+        _event_queue_head = (_event_queue_head + 1) % ESP8266_SSID_FRAMEWORK_EVENT_QUEUE_LEN;
+        _event_queue_count--;
+
+        _esp8266_ssid_framework_event_dispatch_legacy(&record);
+
+        for(i = 0; i < ESP8266_SSID_FRAMEWORK_EVENT_LISTENER_MAX_COUNT; i++)
+        {
+            if(_event_listeners[i].listener != NULL && (_event_listeners[i].mask & ESP8266_SSID_FRAMEWORK_EVENT_MASK(record.type)))
+            {
+                (*_event_listeners[i].listener)(&record, _event_listeners[i].arg);
+            }
+        }
+    }
+}
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_event_dispatch_legacy(ESP8266_SSID_FRAMEWORK_EVENT* event)
+{
+    //MAP EVENTS TO THE WIFI CONNECTED AND LINK UP/DOWN CB FUNCTIONS
+
+    switch(event->type)
+    {
+        case ESP8266_SSID_FRAMEWORK_EVENT_CONNECTED:
+            //WIFI CONNECTED USER CB IS ONLY CALLED ON THE FIRST CONNECTION
+            if(_esp8266_ssid_framework_wifi_connected_user_cb != NULL && !_esp8266_ssid_framework_wifi_connected_user_cb_done)
+            {
+                //DELAY NEEDED TO LET ESP8266 SAVE SSID/PASSWORD IN FLASH
+                //ADDED TO AVOID CRASHING IF THE USER DOES ANY FLASH OPERATION
+                //AS SOON AS THE USER WIFI CONNECTED CB FUNCTION IS EXECUTED
+                //DEFERRED WITH A TIMER, BUSY WAITING HERE WOULD STALL THE EVENT TASK
+                _esp8266_ssid_framework_wifi_connected_user_cb_done = 1;
+                os_timer_disarm(&_connected_user_cb_timer);
+                os_timer_setfn(&_connected_user_cb_timer, _esp8266_ssid_framework_connected_user_cb_timer_cb, NULL);
+                os_timer_arm(&_connected_user_cb_timer, ESP8266_SSID_FRAMEWORK_CONNECTED_CB_DELAY_MS, 0);
+            }
+            if(_esp8266_ssid_framework_link_up_user_cb != NULL)
+            {
+                (*_esp8266_ssid_framework_link_up_user_cb)();
+            }
+            break;
+
+        case ESP8266_SSID_FRAMEWORK_EVENT_LINK_LOST:
+            if(_esp8266_ssid_framework_link_down_user_cb != NULL)
+            {
+                (*_esp8266_ssid_framework_link_down_user_cb)(event->detail);
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_connected_user_cb_timer_cb(void* pArg)
+{
+    //CALL THE WIFI CONNECTED USER CB ONCE THE SDK HAS HAD TIME TO SAVE
+    //THE CREDENTIALS (SEE _esp8266_ssid_framework_event_dispatch_legacy)
+
+    if(_esp8266_ssid_framework_wifi_connected_user_cb != NULL)
+    {
+        (*_esp8266_ssid_framework_wifi_connected_user_cb)(_user_data_ptrs);
+    }
+}
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_wifi_start_ssid_configuration(void)
+{
+    //START THE SSID CONFIGURATION BASED ON CONFIG MODE
+
+    _esp8266_ssid_framework_state = ESP8266_SSID_FRAMEWORK_STATE_PROVISIONING;
+    os_timer_disarm(&_supervisor_probe_timer);
+    os_timer_disarm(&_supervisor_reconnect_timer);
+#if ESP8266_SSID_FRAMEWORK_MODULE_ROAMING
+    os_timer_disarm(&_roam_sample_timer);
+#endif
+#if ESP8266_SSID_FRAMEWORK_MODULE_STATION_MDNS
+    _esp8266_ssid_framework_mdns_stop();
+#endif
+    _esp8266_ssid_framework_event_post(ESP8266_SSID_FRAMEWORK_EVENT_PROVISIONING_STARTED, _config_mode, NULL, NULL);
+#if ESP8266_SSID_FRAMEWORK_MODULE_STATS
+    if(_param_record.stats.portal_entries != 0xFFFF)
+    {
+        _param_record.stats.portal_entries++;
+        _esp8266_ssid_framework_stats_changed();
+    }
+#endif
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_CONFIG_SMARTCONFIG
+    if(_config_mode == ESP8266_SSID_FRAMEWORK_CONFIG_SMARTCONFIG)
+    {
+        //START SMARTCONFIG
+        if(_esp8266_ssid_framework_debug)
+        {
+            os_printf("ESP8266 : SSID FRAMEWORK : Starting config = smartconfig\n");
+        }
+        ESP8266_SMARTCONFIG_SetDebug(_esp8266_ssid_framework_debug);
+        ESP8266_SMARTCONFIG_Initialize();
+        ESP8266_SMARTCONFIG_Start();
+    }
+#endif
+#if ESP8266_SSID_FRAMEWORK_MODULE_CONFIG_WEBCONFIG
+    if(_config_mode == ESP8266_SSID_FRAMEWORK_CONFIG_WEBCONFIG)
+    {
+        //START TCP SERVER WEBCONFIG
+        if(_esp8266_ssid_framework_debug)
+        {
+            os_printf("ESP8266 : SSID FRAMEWORK : Starting config = webconfig\n");
+        }
+
+        //START ESP8266 IN SOFTAP MODE
+        //PORTAL SERVICES ARE STARTED ONCE THE SOFTAP IS UP (AFTER CHANNEL SCAN)
+        _esp8266_ssid_framework_wifi_start_softap();
+    }
+#endif
+}
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_CONFIG_WEBCONFIG
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_webconfig_start(void)
+{
+    //START WEBCONFIG PORTAL SERVICES ON THE SOFTAP
+    //TCP SERVER (CONFIG PAGE) + MDNS
+
+    if(_esp8266_ssid_framework_debug)
+    {
+        os_printf("ESP8266 : SSID FRAMEWORK : Starting SSID = %s\n", _softap_ssid);
+    }
+
+    //RESERVE THE SESSION ARENA. THE CONFIG PAGE HTML BUFFER COMES FROM IT
+    //(RELEASED WHEN THE PORTAL IS TORN DOWN). WITHOUT AN ARENA THE BUFFERS
+    //COME FROM THE HEAP ONE BY ONE. IF NOT EVEN THE PAGE FITS, TRY AGAIN LATER
+    //SO THE PORTAL STILL COMES UP ONCE THE APPLICATION GIVES BACK SOME HEAP
+    os_timer_disarm(&_portal_retry_timer);
+    if(!_esp8266_ssid_framework_arena_reserve())
+    {
+        os_printf("ESP8266 : SSID FRAMEWORK : Portal not started. Retrying in %u ms\n", ESP8266_SSID_FRAMEWORK_PORTAL_RETRY_MS);
+        os_timer_setfn(&_portal_retry_timer, _esp8266_ssid_framework_webconfig_retry_timer_cb, NULL);
+        os_timer_arm(&_portal_retry_timer, ESP8266_SSID_FRAMEWORK_PORTAL_RETRY_MS, 0);
+        return;
+    }
+
+    //START TCP SERVER - SOFTAP MODE
+    ESP8266_TCP_SERVER_SetDebug(_esp8266_ssid_framework_debug);
+    ESP8266_TCP_SERVER_Initialize(80, 1200, 1);
+    ESP8266_TCP_SERVER_SetDataEndingString("\r\n\r\n");
+    ESP8266_TCP_SERVER_SetCallbackFunctions(NULL, NULL, NULL, NULL, _esp8266_ssid_framework_tcp_server_post_data_cb);
+
+    //REGISTER PATH CALLBACKS
+    ESP8266_TCP_SERVER_PATH_CB_ENTRY config_path;
+    config_path.path_string = ESP8266_SSID_FRAMEWORK_WEBCONFIG_PATH_STRING;
+    config_path.path_cb_fn = _esp8266_ssid_framework_tcp_server_path_config_cb;
+    config_path.path_found = 0;
+
+    //GENERATE THE CONFIG PAGE HTML
+    _config_page_status[0] = '\0';
+    _esp8266_ssid_framework_generate_config_page();
+
+    config_path.path_response = _config_page_html;
+    ESP8266_TCP_SERVER_RegisterUrlPathCb(config_path);
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_OTA
+    //FIRMWARE UPLOAD PATH (ANSWERED WITH THE CONFIG PAGE, DATA HANDLED IN POST CB)
+    ESP8266_TCP_SERVER_PATH_CB_ENTRY update_path;
+    update_path.path_string = ESP8266_SSID_FRAMEWORK_OTA_PATH_STRING;
+    update_path.path_cb_fn = _esp8266_ssid_framework_tcp_server_path_config_cb;
+    update_path.path_found = 0;
+    update_path.path_response = _config_page_html;
+    ESP8266_TCP_SERVER_RegisterUrlPathCb(update_path);
+#endif
+
+    ESP8266_TCP_SERVER_Start();
+
+    //START MDNS(SOFTAP MODE)
+    ESP8266_MDNS_SetDebug(_esp8266_ssid_framework_debug);
+    ESP8266_MDNS_Initialize(_mdns_hostname, ESP8266_SSID_FRAMEWORK_MDNS_SERVICE, ESP8266_SSID_FRAMEWORK_MDNS_PORT, 1);
+}
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_webconfig_retry_timer_cb(void* pArg)
+{
+    //NO MEMORY FOR THE CONFIG PAGE LAST TIME. TRY TO START THE PORTAL AGAIN
+
+    if(_esp8266_ssid_framework_state == ESP8266_SSID_FRAMEWORK_STATE_PROVISIONING)
+    {
+        _esp8266_ssid_framework_webconfig_start();
+    }
+}
+
+uint8_t ICACHE_FLASH_ATTR _esp8266_ssid_framework_arena_reserve(void)
+{
+    //RESERVE THE SESSION ARENA AND TAKE THE CONFIG PAGE BUFFER FROM IT
+    //RETURN 0 IF THERE IS NO MEMORY FOR THE PAGE AT ALL
+
+    if(_config_page_html != NULL)
+    {
+        //ALREADY RESERVED FOR THIS SESSION
+        return 1;
+    }
+
+    os_memset(&_session_arena_stats, 0, sizeof(ESP8266_SSID_FRAMEWORK_ARENA_STATS));
+    _session_arena_stats.size = ESP8266_SSID_FRAMEWORK_ARENA_LEN;
+    _session_arena = (uint8_t*)os_malloc(ESP8266_SSID_FRAMEWORK_ARENA_LEN);
+    if(_session_arena == NULL && _esp8266_ssid_framework_debug)
+    {
+        os_printf("ESP8266 : SSID FRAMEWORK : No memory for session arena. Using heap\n");
+    }
+
+    _config_page_html = (char*)_esp8266_ssid_framework_portal_alloc(ESP8266_SSID_FRAMEWORK_CONFIG_PAGE_LEN);
+    if(_config_page_html == NULL)
+    {
+        os_printf("ESP8266 : SSID FRAMEWORK : No memory for config page!\n");
+        return 0;
+    }
+    return 1;
+}
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_arena_release(void)
+{
+    //RELEASE THE CONFIG PAGE AND ALL TRANSIENT PORTAL BUFFERS IN ONE SHOT
+
+    //HEAP FALLBACK BUFFERS ARE FREED ONE BY ONE
+    if(_post_buffer != NULL)
+    {
+        _esp8266_ssid_framework_portal_free(_post_buffer);
+        _post_buffer = NULL;
+    }
+    if(_config_page_html != NULL)
+    {
+        _esp8266_ssid_framework_portal_free(_config_page_html);
+        _config_page_html = NULL;
+    }
+
+    if(_session_arena != NULL)
+    {
+        os_free(_session_arena);
+        _session_arena = NULL;
+    }
+    _session_arena_stats.in_use = 0;
+
+    if(_esp8266_ssid_framework_debug)
+    {
+        os_printf("ESP8266 : SSID FRAMEWORK : Session arena released. High water %u / %u bytes, %u heap fallbacks\n",
+                    _session_arena_stats.high_water, _session_arena_stats.size, _session_arena_stats.fallbacks);
+    }
+}
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_generate_config_page(void)
+{
+    //GENERATE THE CONFIG PAGE HTML INTO THE CONFIG PAGE BUFFER
+    //CALLED AGAIN EVERY TIME THE STATUS ROW CHANGES. BUFFER ADDRESS STAYS THE
+    //SAME SO THE REGISTERED PATH RESPONSE ALWAYS SERVES THE LATEST PAGE
+
+    if(_config_page_html == NULL)
+    {
+        return;
+    }
+
+    _config_page_len = 0;
+    _config_page_html[0] = '\0';
+
+    _esp8266_ssid_framework_page_append("HTTP/1.1 200 OK\r\n"
+                                        "Connection: Closed\r\n"
+                                        "Content-type: text/html"
+                                        "\r\n\r\n"
+                                        "<!DOCTYPE html>"
+                                        "<html><head><title>ESP8266 Web Config</title>");
+
+    char* temp_str = (char*)_esp8266_ssid_framework_portal_alloc(150);
+
+    if(_esp8266_ssid_framework_state == ESP8266_SSID_FRAMEWORK_STATE_CHECKING_CREDENTIALS)
+    {
+        //KEEP THE BROWSER POLLING WHILE THE CREDENTIAL CHECK RUNS
+        os_sprintf(temp_str, "<meta http-equiv=\"refresh\" content=\"%u;url=%s\">",
+                    ESP8266_SSID_FRAMEWORK_PAGE_REFRESH_S,
+                    ESP8266_SSID_FRAMEWORK_WEBCONFIG_PATH_STRING);
+        _esp8266_ssid_framework_page_append(temp_str);
+    }
+
+    _esp8266_ssid_framework_page_append("<style>"
+                                        "html{box-sizing:border-box;font-family:sans-serif;line-height:1.15;-webkit-text-size-adjust:100%;}"
+                                        "</style>"
+                                        "</head>"
+                                        "<body>"
+                                        "<table border=\"0\" cellpadding=\"3\" cellspacing=\"1\" style=\"width:420px;\">"
+                                        "<tbody>"
+                                        "<tr>"
+                                        "<td style=\"text-align: left; vertical-align: middle; background-color: rgb(204, 51, 51);\">"
+                                        "<span style=\"color:#FFFFFF;\"><strong><span style=\"font-size: 18px;\">ESP8266 : Web Config</span></strong></span>"
+                                        "</td>"
+                                        "</tr>"
+                                        "<td style=\"text-align: left; vertical-align: middle; background-color: rgb(204, 51, 51);\">"
+                                        "<span style=\"color:#FFFFFF;\"><strong><span style=\"font-size: 18px;\">");
+
+    //ADD PROJECT NAME
+    _esp8266_ssid_framework_page_append(_project_name);
+    _esp8266_ssid_framework_page_append("</span></strong></span>");
+
+    //ADD COMMON CONFIGURATION
+    _esp8266_ssid_framework_page_append("</td>"
+                                        "</tbody>"
+                                        "</table>"
+                                        "<form action=\"/config\" method=\"POST\">"
+                                        "<table align=\"left\" border=\"0\" cellpadding=\"1\" cellspacing=\"1\" style=\"width:420px;\">"
+                                        "<tbody>");
+
+    //ADD CREDENTIAL CHECK STATUS IF ANY
+    //ESCAPED : IT CARRIES THE SUBMITTED SSID
+    if(_config_page_status[0] != '\0')
+    {
+        _esp8266_ssid_framework_page_append("<tr><td colspan=\"2\" style=\"background-color: rgb(204, 204, 204);\"><strong>");
+        _esp8266_ssid_framework_page_append_escaped(_config_page_status);
+        _esp8266_ssid_framework_page_append("</strong></td></tr>");
+    }
+
+    _esp8266_ssid_framework_page_append("<tr>"
+                                        "<td colspan=\"2\" style=\"background-color: rgb(255, 204, 51);\"><span style=\"font-size:18px;\"><strong>Basic Configuration</strong></span></td>"
+                                        "</tr>");
+
+    //ADD SSID / PASSWORD INPUT
+    //FILL WITH SAVED ONES IF PRESENT
+    struct station_config config;
+    char* format_str = "<td><input type=\"text\" name=\"%s\"></td>";
+    wifi_station_get_config(&config);
+    if(config.ssid[0] >= 28 && config.ssid[0] <= 126 && config.password[0] >= 28 && config.password[0] <= 126)
+    {
+        //SAVED WIFI CREDENTIALS PRESENT
+        _esp8266_ssid_framework_page_append("<tr>"
+                                            "<td style=\"background-color: rgb(0, 0, 0); text-align: left; vertical-align: middle;\">"
+                                            "<span style=\"color:#FFFFFF;\">SSID</span></td>");
+        os_sprintf(temp_str, format_str, "ssid", config.ssid);
+        _esp8266_ssid_framework_page_append(temp_str);
+        _esp8266_ssid_framework_page_append("</tr>");
+
+        _esp8266_ssid_framework_page_append("<tr>"
+                                            "<td style=\"background-color: rgb(0, 0, 0); text-align: left; vertical-align: middle;\">"
+                                            "<span style=\"color:#FFFFFF;\">PASSWORD</span></td>");
+        os_sprintf(temp_str, format_str, "password", config.password);
+        _esp8266_ssid_framework_page_append(temp_str);
+        _esp8266_ssid_framework_page_append("</tr>");
+    }
+    else
+    {
+        //NO SAVED WIFI CREDENTIALS PRESENT
+        _esp8266_ssid_framework_page_append("<tr>"
+                                            "<td style=\"background-color: rgb(0, 0, 0); text-align: left; vertical-align: middle;\">"
+                                            "<span style=\"color:#FFFFFF;\">SSID</span></td>"
+                                            "<td><input name=\"ssid\" type=\"text\" /></td>"
+                                            "</tr>"
+                                            "<tr>"
+                                            "<td style=\"background-color: rgb(0, 0, 0);\"><span style=\"color:#FFFFFF;\">PASSWORD</span></td>"
+                                            "<td><input name=\"password\" type=\"text\"/></td>"
+                                            "</tr>");
+    }
+
+    _esp8266_ssid_framework_portal_free(temp_str);
+    _esp8266_ssid_framework_page_append("<tr>"
+                                        "<td colspan=\"2\" style=\"background-color: rgb(255, 204, 51);\">"
+                                        "<span style=\"font-size:18px;\"><strong>Additional Configuration</strong></span></td>"
+                                        "</tr>");
+
+    //ADD CUSTOM CONFIG FIELDS IF ANY
+    //INPUT ELEMENT FOLLOWS THE FIELD TYPE, FILLED WITH THE STORED VALUE
+    if(_custom_user_field_group != NULL &&_custom_user_field_group->custom_fields_count != 0)
+    {
+        //USER CUSTOM FIELDS PRESENT
+        uint8_t i = 0;
+        while(i < _custom_user_field_group->custom_fields_count)
+        {
+            _esp8266_ssid_framework_page_append("<tr><td style=\"background-color: rgb(0, 0, 0); text-align: left; vertical-align: middle;\">"
+                                                "<span style=\"color:#FFFFFF;\">");
+            _esp8266_ssid_framework_page_append_escaped((_custom_user_field_group->custom_fields + i)->custom_field_label);
+            _esp8266_ssid_framework_page_append("</span></td><td>");
+            _esp8266_ssid_framework_page_append_field(i);
+            _esp8266_ssid_framework_page_append("</td></tr>");
+            i++;
+        }
+    }
+
+    //ADD IP CONFIGURATION FIELDS
+    //FILL WITH SAVED STATIC SETTINGS IF PRESENT
+    _esp8266_ssid_framework_page_append("<tr>"
+                                        "<td colspan=\"2\" style=\"background-color: rgb(255, 204, 51);\">"
+                                        "<span style=\"font-size:18px;\"><strong>IP Configuration</strong></span> (empty IP = DHCP)</td>"
+                                        "</tr>");
+    const char* ip_labels[4] = {"IP", "NETMASK", "GATEWAY", "DNS"};
+    const char* ip_names[4] = {"ip", "netmask", "gateway", "dns"};
+    ip_addr_t ip_values[4];
+    char ip_value_str[16];
+    char* row_line = (char*)_esp8266_ssid_framework_portal_alloc(250);
+    uint8_t i;
+
+    ip_values[0] = _param_record.static_ip.ip;
+    ip_values[1] = _param_record.static_ip.netmask;
+    ip_values[2] = _param_record.static_ip.gw;
+    ip_values[3] = _param_record.static_dns;
+    for(i = 0; i < 4; i++)
+    {
+        ip_value_str[0] = '\0';
+        if(_param_record.ip_mode == ESP8266_SSID_FRAMEWORK_IP_MODE_STATIC && ip_values[i].addr != 0)
+        {
+            os_sprintf(ip_value_str, IPSTR, IP2STR(&ip_values[i]));
+        }
+        os_sprintf(row_line, "<tr><td style=\"background-color: rgb(0, 0, 0); text-align: left; vertical-align: middle;\">"
+                            "<span style=\"color:#FFFFFF;\">%s</span></td><td><input type=\"text\" name=\"%s\" value=\"%s\"></td></tr>",
+                            ip_labels[i], ip_names[i], ip_value_str);
+        _esp8266_ssid_framework_page_append(row_line);
+    }
+    _esp8266_ssid_framework_portal_free(row_line);
+
+    //ADD MORE HTML
+    _esp8266_ssid_framework_page_append("<tr>"
+                                        "<td colspan=\"2\" style=\"text-align: right; vertical-align: middle;\">"
+                                        "<input type=\"submit\" value=\"   Save   \" />"
+                                        "</td>"
+                                        "</tr>");
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_OTA
+    //ADD FIRMWARE UPDATE
+    //IMAGE IS SENT AS RAW BODY WITH ITS CRC32 AND THE UPDATE KEY IN HEADERS, THEN THE PAGE IS RELOADED FOR THE RESULT
+    _esp8266_ssid_framework_page_append("<tr>"
+                                        "<td colspan=\"2\" style=\"background-color: rgb(255, 204, 51);\">"
+                                        "<span style=\"font-size:18px;\"><strong>Firmware Update</strong></span></td>"
+                                        "</tr>"
+                                        "<tr><td colspan=\"2\"><input type=\"file\" id=\"fw\"/>"
+                                        "<input type=\"password\" id=\"fk\" placeholder=\"Update key\" size=\"10\"/>"
+                                        "<input type=\"button\" value=\"Upload\" onclick=\"up()\"/> <span id=\"us\"></span>"
+                                        "<script>function up(){var f=document.getElementById('fw').files[0];if(!f)return;"
+                                        "var r=new FileReader();r.onload=function(){var d=new Uint8Array(r.result),c=-1,i,k;"
+                                        "for(i=0;i<d.length;i++){c^=d[i];for(k=0;k<8;k++)c=(c>>>1)^(0xEDB88320&-(c&1));}"
+                                        "var x=new XMLHttpRequest();x.open('POST','");
+    _esp8266_ssid_framework_page_append(ESP8266_SSID_FRAMEWORK_OTA_PATH_STRING);
+    _esp8266_ssid_framework_page_append("');x.setRequestHeader('X-Firmware-CRC32',((c^-1)>>>0).toString(16));"
+                                        "x.setRequestHeader('X-Firmware-Key',document.getElementById('fk').value);"
+                                        "x.onloadend=function(){setTimeout(function(){location.href='");
+    _esp8266_ssid_framework_page_append(ESP8266_SSID_FRAMEWORK_WEBCONFIG_PATH_STRING);
+    _esp8266_ssid_framework_page_append("';},1000);};"
+                                        "document.getElementById('us').innerHTML='Uploading ...';x.send(d);};"
+                                        "r.readAsArrayBuffer(f);}</script></td></tr>");
+#endif
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_SYSTEM_PARAMS
+    //ADD SYSTEM PARAMS SECTION
+    _esp8266_ssid_framework_page_append("<tr>"
+                                        "<td colspan=\"2\" style=\"background-color: rgb(255, 204, 51);\"><span style=\"font-size:18px;\"><strong>System Params</strong></span>"
+                                        "<ul>");
+
+    temp_str = (char*)_esp8266_ssid_framework_portal_alloc(100);
+    uint8_t mac[6];
+    os_sprintf(temp_str, "<li>CPU Frequency : %dMHz</li>", ESP8266_SYSINFO_GetCpuFrequency());
+    _esp8266_ssid_framework_page_append(temp_str);
+
+    os_sprintf(temp_str, "<li>ESP8266 Chip ID : %x</li>", system_get_chip_id());
+    _esp8266_ssid_framework_page_append(temp_str);
+
+    os_sprintf(temp_str, "<li>mDNS Name : %s.local</li>", _mdns_hostname);
+    _esp8266_ssid_framework_page_append(temp_str);
+
+    ESP8266_SYSINFO_GetSystemMac(mac);
+    os_sprintf(temp_str, "<li>MAC Address : %02X:%02X:%02X:%02X:%02X:%02X</li>", mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+    _esp8266_ssid_framework_page_append(temp_str);
+
+    os_sprintf(temp_str, "<li>Flash Chip ID : 0x%X</li>", ESP8266_SYSINFO_GetFlashChipId());
+    _esp8266_ssid_framework_page_append(temp_str);
+
+    uint8_t map = ESP8266_SYSINFO_GetSystemFlashMap();
+    switch(map)
+    {
+        case FLASH_SIZE_4M_MAP_256_256:
+                _esp8266_ssid_framework_page_append("<li>Flash size : 4Mbits. Map : 256KBytes + 256KBytes</li>");
+                break;
+        case FLASH_SIZE_2M:
+                _esp8266_ssid_framework_page_append("<li>Flash size : 2Mbits. Map : 256KBytes</li>");
+                break;
+        case FLASH_SIZE_8M_MAP_512_512:
+                _esp8266_ssid_framework_page_append("<li>Flash size : 8Mbits. Map : 512KBytes + 512KBytes</li>");
+                break;
+        case FLASH_SIZE_16M_MAP_512_512:
+                _esp8266_ssid_framework_page_append("<li>Flash size : 16Mbits. Map : 512KBytes + 512KBytes</li>");
+                break;
+        case FLASH_SIZE_32M_MAP_512_512:
+                _esp8266_ssid_framework_page_append("<li>Flash size : 32Mbits. Map : 512KBytes + 512KBytes</li>");
+                break;
+        case FLASH_SIZE_16M_MAP_1024_1024:
+                _esp8266_ssid_framework_page_append("<li>Flash size : 16Mbits. Map : 1024KBytes + 1024KBytes</li>");
+                break;
+        case FLASH_SIZE_32M_MAP_1024_1024:
+                _esp8266_ssid_framework_page_append("<li>Flash size : 32Mbits. Map : 1024KBytes + 1024KBytes</li>");
+                break;
+        /*case FLASH_SIZE_32M_MAP_2048_2048:
+                strcpy(&_config_page_html[os_strlen(_config_page_html)], "<li>Flash size : 32Mbits. Map : 2048KBytes + 2048KBytes (Not Supported)</li>");
+                break;*
+        case FLASH_SIZE_64M_MAP_1024_1024:
+                strcpy(&_config_page_html[os_strlen(_config_page_html)], "<li>Flash size : 64Mbits. Map : 1024KBytes + 1024KBytes</li>");
+                break;
+        case FLASH_SIZE_128M_MAP_1024_1024:
+                strcpy(&_config_page_html[os_strlen(_config_page_html)], "<li>Flash size : 128Mbits. Map : 1024KBytes + 1024KBytes</li>");
+                break;*/
+    }
+
+    uint8_t flashmode = ESP8266_SYSINFO_GetFlashChipMode();
+    switch(flashmode)
+    {
+        case 0:
+            _esp8266_ssid_framework_page_append("<li>Flash Mode : QIO</li>");
+            break;
+        case 1:
+            _esp8266_ssid_framework_page_append("<li>Flash Mode : QOUT</li>");
+            break;
+        case 2:
+            _esp8266_ssid_framework_page_append("<li>Flash Mode : DIO</li>");
+            break;
+        case 3:
+            _esp8266_ssid_framework_page_append("<li>Flash Mode : DOUT</li>");
+            break;
+        default:
+            _esp8266_ssid_framework_page_append("<li>Flash Mode : UNKNOWN</li>");
+            break;
+    }
+
+    os_sprintf(temp_str, "<li>SDK Version : %s</li>", ESP8266_SYSINFO_GetSDKVersion());
+    _esp8266_ssid_framework_page_append(temp_str);
+
+    os_sprintf(temp_str, "<li>Time To IP : DHCP %u ms | Static %u ms | Lease %u ms</li>",
+                _ip_time_to_ip_ms[ESP8266_SSID_FRAMEWORK_IP_MODE_DHCP],
+                _ip_time_to_ip_ms[ESP8266_SSID_FRAMEWORK_IP_MODE_STATIC],
+                _ip_time_to_ip_ms[ESP8266_SSID_FRAMEWORK_IP_MODE_LEASE_REUSE]);
+    _esp8266_ssid_framework_page_append(temp_str);
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_STATS
+    ESP8266_SSID_FRAMEWORK_STATS* stats = &_param_record.stats;
+
+    os_sprintf(temp_str, "<li>Boots : %u | Config Portal Entries : %u</li>", stats->boot_count, stats->portal_entries);
+    _esp8266_ssid_framework_page_append(temp_str);
+
+    if(stats->rssi_samples != 0)
+    {
+        os_sprintf(temp_str, "<li>RSSI Min / Avg / Max : %d / %d / %d dBm (%u samples)</li>",
+                    stats->rssi_min, stats->rssi_avg_x16 / 16, stats->rssi_max, stats->rssi_samples);
+        _esp8266_ssid_framework_page_append(temp_str);
+    }
+
+    _esp8266_ssid_framework_page_append("<li>Time To IP Histogram :");
+    for(i = 0; i < ESP8266_SSID_FRAMEWORK_STATS_TTI_BUCKET_COUNT; i++)
+    {
+        if(i < ESP8266_SSID_FRAMEWORK_STATS_TTI_BUCKET_COUNT - 1)
+        {
+            os_sprintf(temp_str, " &lt;%ums %u |", ESP8266_SSID_FRAMEWORK_STATS_TTI_BUCKET_BASE_MS << i, stats->time_to_ip[i]);
+        }
+        else
+        {
+            os_sprintf(temp_str, " longer %u", stats->time_to_ip[i]);
+        }
+        _esp8266_ssid_framework_page_append(temp_str);
+    }
+    _esp8266_ssid_framework_page_append("</li><li>Disconnects (reason x count) :");
+    for(i = 0; i < ESP8266_SSID_FRAMEWORK_REASON_SLOT_COUNT; i++)
+    {
+        if(stats->disconnects[i] != 0)
+        {
+            os_sprintf(temp_str, " %u x%u", (i < 25) ? i : (REASON_BEACON_TIMEOUT + i - 25), stats->disconnects[i]);
+            _esp8266_ssid_framework_page_append(temp_str);
+        }
+    }
+    _esp8266_ssid_framework_page_append("</li>");
+#endif
+
+    _esp8266_ssid_framework_portal_free(temp_str);
+
+    _esp8266_ssid_framework_page_append("</ul>"
+                                        "</td>"
+                                        "</tr>");
+#endif
+
+    //ADD ENDING HTML
+    _esp8266_ssid_framework_page_append("</tbody>"
+                                        "</table>"
+                                        "</form>"
+                                        "</body>"
+                                        "</html>");
+}
+#endif
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_wifi_start_connection_process(struct station_config* sconfig)
+{
+    //START WIFI CONNECTION PROCESS
+    //CREDENTIALS ARE TRIED FROM A CANDIDATE LIST IN ORDER. EACH CANDIDATE GETS
+    //THE CONFIGURED NUMBER OF RETRIES, A TERMINAL DISCONNECT REASON MOVES ON TO
+    //THE NEXT CANDIDATE AT ONCE. WHEN ALL ARE EXHAUSTED, SSID CONFIGURAION STARTS
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_INPUT_HARDCODED
+    struct station_config config;
+#endif
+
+    _esp8266_ssid_framework_wifi_connected = 0;
+    _esp8266_ssid_framework_state = ESP8266_SSID_FRAMEWORK_STATE_CONNECTING;
+    _ssid_supplied_config = sconfig;
+    _ssid_candidate_count = 0;
+    _ssid_candidate_index = 0;
+
+    wifi_set_opmode(STATION_MODE);
+    os_delay_us(100);
+    wifi_station_set_auto_connect(FALSE);
+    wifi_station_set_reconnect_policy(FALSE);
+#if ESP8266_SSID_FRAMEWORK_MODULE_CREDENTIAL_CRYPT
+    _esp8266_ssid_framework_credential_migrate();
+#endif
+
+    if(sconfig != NULL)
+    {
+        //USE THE SUPPLIED CREDENTIALS ONLY
+        _ssid_candidates[_ssid_candidate_count++] = ESP8266_SSID_FRAMEWORK_SSID_SOURCE_SUPPLIED;
+    }
+    else
+    {
+        switch(_input_mode)
+        {
+#if ESP8266_SSID_FRAMEWORK_MODULE_INPUT_GPIO
+            case ESP8266_SSID_FRAMEWORK_SSID_INPUT_GPIO:
+#endif
+#if ESP8266_SSID_FRAMEWORK_MODULE_INPUT_INTERNAL
+            case ESP8266_SSID_FRAMEWORK_SSID_INPUT_INTERNAL:
+#endif
+#if ESP8266_SSID_FRAMEWORK_MODULE_INPUT_GPIO || ESP8266_SSID_FRAMEWORK_MODULE_INPUT_INTERNAL
+                //SIMPLY ATTEMPT TO CONNECT TO WIFI USING INTERNAL CACHE
+                _ssid_candidates[_ssid_candidate_count++] = ESP8266_SSID_FRAMEWORK_SSID_SOURCE_INTERNAL;
+                break;
+#endif
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_INPUT_HARDCODED
+            case ESP8266_SSID_FRAMEWORK_SSID_INPUT_HARDCODED:
+                //CHECK IF ESP8266 HAS VALID INTERNAL STORED WIFI CREDENTIALS
+                //IF PRESENT, TRY THOSE FIRST
+                //HARDCODED SSID DATA IS ALWAYS THE LAST CANDIDATE
+                _esp8266_ssid_framework_load_candidate(ESP8266_SSID_FRAMEWORK_SSID_SOURCE_INTERNAL, &config);
+                if(_esp8266_ssid_framework_check_valid_stationconfig(&config) &&
+                    (os_strncmp((char*)config.ssid, _ssid_hardcoded_name_pwd.ssid_name, ESP8266_SSID_FRAMEWORK_SSID_NAME_LEN) != 0 ||
+                    os_strncmp((char*)config.password, _ssid_hardcoded_name_pwd.ssid_pwd, ESP8266_SSID_FRAMEWORK_SSID_PSWD_LEN) != 0))
+                {
+                    if(_esp8266_ssid_framework_debug)
+                    {
+                        os_printf("ESP8266 : SSID FRAMEWORK : Internal saved SSID valid. Using that first\n");
+                    }
+                    _ssid_candidates[_ssid_candidate_count++] = ESP8266_SSID_FRAMEWORK_SSID_SOURCE_INTERNAL;
+                }
+                _ssid_candidates[_ssid_candidate_count++] = ESP8266_SSID_FRAMEWORK_SSID_SOURCE_HARDCODED;
+                break;
+#endif
+
+            default:
+                break;
+        }
+    }
+
+    //SETUP WIFI CONNECTION TIMER
+    os_timer_disarm(&_wifi_connect_timer);
+    os_timer_setfn(&_wifi_connect_timer, _esp8266_ssid_framework_wifi_connect_timer_cb, NULL);
+
+    _esp8266_ssid_framework_wifi_connect_candidate();
+}
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_wifi_connect_candidate(void)
+{
+    //ATTEMPT WIFI CONNECTION WITH THE CURRENT CANDIDATE CREDENTIALS
+    //START SSID CONFIGURATION IF NO CANDIDATES LEFT
+
+    struct station_config config;
+
+    os_timer_disarm(&_wifi_connect_timer);
+
+    if(_ssid_candidate_index >= _ssid_candidate_count)
+    {
+        //ALL CANDIDATES TRIED
+        if(_esp8266_ssid_framework_debug)
+        {
+            os_printf("ESP8266 : SSID FRAMEWORK : No more ssid candidates\n");
+        }
+
+        //START THE SSID CONFIGURATION PROCESS
+        wifi_station_disconnect();
+        _esp8266_ssid_framework_wifi_start_ssid_configuration();
+        return;
+    }
+
+    _ssid_connect_retry_count = 1;
+    _esp8266_ssid_framework_load_candidate(_ssid_candidates[_ssid_candidate_index], &config);
+    _esp8266_ssid_framework_event_post(ESP8266_SSID_FRAMEWORK_EVENT_CONNECTING, _ssid_candidates[_ssid_candidate_index], NULL, NULL);
+
+    if(_esp8266_ssid_framework_debug)
+    {
+        os_printf("ESP8266 : SSID FRAMEWORK : ssid candidate #%u (source %u)\n", _ssid_candidate_index, _ssid_candidates[_ssid_candidate_index]);
+        os_printf("ESP8266 : SSID FRAMEWORK : ssid = %s\n", config.ssid);
+#if ESP8266_SSID_FRAMEWORK_PRINT_SECRETS
+        os_printf("ESP8266 : SSID FRAMEWORK : pswd = %s\n", config.password);
+#endif
+    }
+
+    wifi_station_disconnect();
+    wifi_station_set_config_current(&config);
+    _esp8266_ssid_framework_ip_apply(_param_record.ip_mode, &_param_record.static_ip, &_param_record.static_dns, config.ssid);
+    wifi_station_connect();
+
+    os_timer_arm(&_wifi_connect_timer, _ssid_connect_retry_delay_ms, 0);
+}
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_CONFIG_WEBCONFIG
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_wifi_start_softap(void)
+{
+    //START SOFTAP ON ESP8266
+    //SSID = <PROJECT NAME>-<LAST 3 MAC BYTES> | PASSWORD = 12345678
+    //SCAN ONCE FIRST (STATION MODE) TO PICK THE LEAST CONGESTED CHANNEL
+
+    uint8_t mac[6];
+    char* name = (_project_name != NULL) ? _project_name : "ESP8266";
+    uint8_t name_len = os_strlen(name);
+
+    //BUILD UNIQUE SSID
+    if(name_len > ESP8266_SSID_FRAMEWORK_SSID_NAME_LEN - 7)
+    {
+        name_len = ESP8266_SSID_FRAMEWORK_SSID_NAME_LEN - 7;
+    }
+    ESP8266_SYSINFO_GetSystemMac(mac);
+    os_memcpy(_softap_ssid, name, name_len);
+    os_sprintf(&_softap_ssid[name_len], "-%02X%02X%02X", mac[3], mac[4], mac[5]);
+
+    wifi_station_disconnect();
+    wifi_set_opmode_current(STATION_MODE);
+    if(!wifi_station_scan(NULL, _esp8266_ssid_framework_softap_scan_done_cb))
+    {
+        _esp8266_ssid_framework_softap_scan_done_cb(NULL, FAIL);
+    }
+}
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_softap_scan_done_cb(void* arg, STATUS status)
+{
+    //CB FUNCTION FOR SOFTAP CHANNEL SCAN DONE
+    //SCORE EVERY CHANNEL BY THE APS HEARD ON IT AND ITS OVERLAPPING NEIGHBOURS
+    //(STRONGER AP = HIGHER WEIGHT), BRING UP THE SOFTAP ON THE QUIETEST ONE
+
+    struct softap_config config;
+    uint32_t score[ESP8266_SSID_FRAMEWORK_SOFTAP_CHANNEL_MAX + 1];
+    uint8_t channel = ESP8266_SSID_FRAMEWORK_SOFTAP_DEFAULT_CHANNEL;
+    uint8_t i;
+
+    if(_esp8266_ssid_framework_state != ESP8266_SSID_FRAMEWORK_STATE_PROVISIONING)
+    {
+        return;
+    }
+
+    if(status == OK)
+    {
+        os_memset(score, 0, sizeof(score));
+
+        struct bss_info* bss = (struct bss_info*)arg;
+        while(bss != NULL)
+        {
+            //WEIGHT = RSSI ABOVE -100dBm (MIN 1)
+            int16_t weight = bss->rssi + 100;
+            if(weight < 1)
+            {
+                weight = 1;
+            }
+
+            //22MHz WIDE CHANNELS AT 5MHz SPACING OVERLAP UP TO +/- 4 CHANNELS
+            //THE SAME CHANNEL COUNTS FULLY, EACH CHANNEL FURTHER AWAY LESS
+            for(i = 1; i <= ESP8266_SSID_FRAMEWORK_SOFTAP_CHANNEL_MAX; i++)
+            {
+                uint8_t distance = (i > bss->channel) ? (i - bss->channel) : (bss->channel - i);
+                if(distance <= ESP8266_SSID_FRAMEWORK_SOFTAP_CHANNEL_OVERLAP)
+                {
+                    score[i] += weight * (ESP8266_SSID_FRAMEWORK_SOFTAP_CHANNEL_OVERLAP + 1 - distance);
+                }
+            }
+            bss = STAILQ_NEXT(bss, next);
+        }
+
+        for(i = 1; i <= ESP8266_SSID_FRAMEWORK_SOFTAP_CHANNEL_MAX; i++)
+        {
+            if(score[i] < score[channel])
+            {
+                channel = i;
+            }
+        }
+
+        if(_esp8266_ssid_framework_debug)
+        {
+            os_printf("ESP8266 : SSID FRAMEWORK : Softap channel %u selected (score %u)\n", channel, score[channel]);
+        }
+    }
+    else if(_esp8266_ssid_framework_debug)
+    {
+        os_printf("ESP8266 : SSID FRAMEWORK : Softap channel scan failed. Using channel %u\n", channel);
+    }
+
+    wifi_set_opmode(SOFTAP_MODE);
+
+    wifi_softap_get_config(&config);
+    os_memset(config.ssid, 0, ESP8266_SSID_FRAMEWORK_SSID_NAME_LEN);
+    os_memset(config.password, 0, ESP8266_SSID_FRAMEWORK_SSID_PSWD_LEN);
+    os_memcpy(config.ssid, _softap_ssid, os_strlen(_softap_ssid));
+    os_memcpy(config.password, "12345678", 8);
+    config.ssid_len = os_strlen(_softap_ssid);
+    config.channel = channel;
+    config.authmode = AUTH_WEP;
+    config.ssid_hidden = 0;
+    config.max_connection = 2;
+    wifi_softap_set_config_current(&config);
+
+    _esp8266_ssid_framework_webconfig_start();
+}
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_tcp_server_path_config_cb(void)
+{
+    //CB FUNCTION FOR CONFIG PATH FOUND IN TCP SERVER REQUESTS
+
+    if(_esp8266_ssid_framework_debug)
+    {
+        os_printf("ESP8266 : SSID FRAMEWORK : Config path found!!\n");
+    }
+
+    if(_portal_teardown_pending && !_portal_result_served)
+    {
+        //THE CHECK RESULT IS BEING SERVED. CLOSE THE PORTAL TEARDOWN DELAY
+        //FROM NOW INSTEAD OF WAITING OUT THE RESULT GRACE PERIOD
+        _portal_result_served = 1;
+        os_timer_disarm(&_portal_teardown_timer);
+        os_timer_arm(&_portal_teardown_timer, ESP8266_SSID_FRAMEWORK_PORTAL_TEARDOWN_DELAY_MS, 0);
+    }
+}
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_tcp_server_post_data_cb(char* data, uint16_t len, uint8_t post_flag)
+{
+    //CB FUNCTION FOR TCP SERVER FOR TCP DATA RECEIVED
+    //POST FLAG = 1 : POST DATA
+    //POST FLAG = 0 : GET DATA (IGNORE : PATH CB WILL HANDLE IT) OR THE REST OF A FRAGMENTED POST
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_OTA
+    //FIRMWARE UPLOAD. EVERY CHUNK AFTER THE REQUEST HEADER GOES STRAIGHT TO FLASH
+    if(_ota_active)
+    {
+        _esp8266_ssid_framework_ota_write((uint8_t*)data, len);
+        return;
+    }
+    if(post_flag && os_strncmp(data, "POST " ESP8266_SSID_FRAMEWORK_OTA_PATH_STRING, os_strlen("POST " ESP8266_SSID_FRAMEWORK_OTA_PATH_STRING)) == 0)
+    {
+        _esp8266_ssid_framework_ota_begin(data, len);
+        return;
+    }
+#endif
+
+    if(_post_buffer != NULL && !(post_flag && os_strncmp(data, "POST ", 5) == 0))
+    {
+        //REST OF A FRAGMENTED FORM POST
+        _esp8266_ssid_framework_post_reassemble(data, len);
+        return;
+    }
+
+    if(post_flag)
+    {
+        //THE FORM BODY CAN ARRIVE AFTER THE HEADER. COLLECT ALL OF IT FIRST
+        //A NEW REQUEST DROPS AN UNFINISHED ONE
+        char* body = (char*)os_strstr(data, "\r\n\r\n");
+        uint32_t content_len;
+
+        if(_post_buffer != NULL)
+        {
+            _esp8266_ssid_framework_portal_free(_post_buffer);
+            _post_buffer = NULL;
+        }
+
+        if(body != NULL && _esp8266_ssid_framework_header_value(data, "Content-Length", 0, &content_len) &&
+            (body + 4 - data) + content_len > len)
+        {
+            _post_expected = (body + 4 - data) + content_len;
+            if(_post_expected > ESP8266_SSID_FRAMEWORK_POST_MAX_LEN ||
+                (_post_buffer = (char*)_esp8266_ssid_framework_portal_alloc(_post_expected + 1)) == NULL)
+            {
+                os_strcpy(_config_page_status, "Request too large");
+                _esp8266_ssid_framework_generate_config_page();
+                return;
+            }
+            _post_len = 0;
+            _esp8266_ssid_framework_post_reassemble(data, len);
+            return;
+        }
+
+        _esp8266_ssid_framework_form_post(data);
+    }
+}
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_post_reassemble(char* data, uint16_t len)
+{
+    //COLLECT A FRAGMENTED FORM POST. HANDLE IT ONCE CONTENT LENGTH IS REACHED
+
+    char* request;
+
+    if(len > _post_expected - _post_len)
+    {
+        len = _post_expected - _post_len;
+    }
+    os_memcpy(&_post_buffer[_post_len], data, len);
+    _post_len += len;
+#if ESP8266_SSID_FRAMEWORK_MODULE_PORTAL_BENCH
+    _bench_bytes_copied += len;
+#endif
+
+    if(_post_len < _post_expected)
+    {
+        return;
+    }
+
+    //BUFFER IS ZEROED, SO THE REQUEST IS TERMINATED
+    request = _post_buffer;
+    _post_buffer = NULL;
+    _esp8266_ssid_framework_form_post(request);
+    _esp8266_ssid_framework_portal_free(request);
+}
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_form_post(char* data)
+{
+    //HANDLE A COMPLETE CONFIG FORM POST (HEADER + BODY, NULL TERMINATED)
+
+    if(_esp8266_ssid_framework_debug)
+    {
+        os_printf("ESP8266 : SSID FRAMEWORK : SSID configuration data received!\n");
+    }
+
+    if(_esp8266_ssid_framework_state != ESP8266_SSID_FRAMEWORK_STATE_PROVISIONING)
+    {
+        //CREDENTIAL CHECK ALREADY RUNNING OR PORTAL CLOSING
+        if(_esp8266_ssid_framework_debug)
+        {
+            os_printf("ESP8266 : SSID FRAMEWORK : Credential check busy. Data ignored\n");
+        }
+        return;
+    }
+
+    //EXTRACT SSID NAME / PASSWORD / CUSTOM FIELDS (IF ANY) / IP SETTINGS
+    //FIELDS ARE LOOKED UP BY NAME (URL DECODED) IN THE FORM BODY
+    char ssid[ESP8266_SSID_FRAMEWORK_SSID_NAME_LEN + 1];
+    char pswd[ESP8266_SSID_FRAMEWORK_SSID_PSWD_LEN + 1];
+    char ip_str[16];
+    char netmask_str[16];
+    char gateway_str[16];
+    char dns_str[16];
+
+    char* body = strstr(data, "\r\n\r\n");
+    body = (body != NULL) ? body + 4 : data;
+
+    _esp8266_ssid_framework_form_value(body, "ssid", ssid, sizeof(ssid));
+    _esp8266_ssid_framework_form_value(body, "password", pswd, sizeof(pswd));
+    _esp8266_ssid_framework_form_value(body, "ip", ip_str, sizeof(ip_str));
+    _esp8266_ssid_framework_form_value(body, "netmask", netmask_str, sizeof(netmask_str));
+    _esp8266_ssid_framework_form_value(body, "gateway", gateway_str, sizeof(gateway_str));
+    _esp8266_ssid_framework_form_value(body, "dns", dns_str, sizeof(dns_str));
+
+    if(ssid[0] == '\0' || pswd[0] == '\0')
+    {
+        //EITHER THE SSID OR PASSWORD EMPTY
+        os_printf("ESP8266 : SSID FRAMEWORK : Either ssid or password empty\n");
+        os_strcpy(_config_page_status, "Either SSID or password empty");
+        _esp8266_ssid_framework_generate_config_page();
+        return;
+    }
+
+    //EXTRACT AND VALIDATE CUSTOM FIELDS DATA
+    //VALUES ARE ENCODED INTO THE PACKED STORE NOW, BUT ONLY SAVED (AND PASSED
+    //TO THE USER CB) ONCE THE CREDENTIAL CHECK HAS PASSED
+    //EMPTY FIELD = NO VALUE. AN UNCHECKED BOOL IS NOT SENT AT ALL AND MEANS 0
+    uint8_t i = 0;
+    char field_str[ESP8266_SSID_FRAMEWORK_CUSTOM_FIELD_VALUE_LEN + 1];
+    ESP8266_SSID_FRAMEWORK_CONFIG_USER_FIELD* field;
+    _credential_check_custom_present = 0;
+    os_memset(_credential_check_custom_values, 0, ESP8266_SSID_FRAMEWORK_CUSTOM_FIELD_STORE_LEN);
+    if(_custom_user_field_group != NULL)
+    {
+        while (i < _custom_user_field_group->custom_fields_count)
+        {
+            field = _custom_user_field_group->custom_fields + i;
+            _esp8266_ssid_framework_form_value(body, field->custom_field_name, field_str, sizeof(field_str));
+            if(field_str[0] != '\0' || field->custom_field_type == ESP8266_SSID_FRAMEWORK_FIELD_BOOL)
+            {
+                if(!_esp8266_ssid_framework_field_encode(field, field_str, &_credential_check_custom_values[_custom_field_offset[i]]))
+                {
+                    os_sprintf(_config_page_status, "Invalid value for %s", field->custom_field_name);
+                    _esp8266_ssid_framework_generate_config_page();
+                    return;
+                }
+                _credential_check_custom_present |= (1 << i);
+            }
+            i++;
+        }
+    }
+
+    //IP SETTINGS. EMPTY IP = DHCP (OR THE LEASE REUSE MODE SET BY THE APPLICATION)
+    //NETMASK DEFAULTS TO 255.255.255.0, DNS IS OPTIONAL
+    _credential_check_ip_mode = _param_record.ip_mode;
+    _credential_check_ip = _param_record.static_ip;
+    _credential_check_dns = _param_record.static_dns;
+    if(ip_str[0] != '\0')
+    {
+        _credential_check_ip_mode = ESP8266_SSID_FRAMEWORK_IP_MODE_STATIC;
+        _credential_check_ip.netmask.addr = 0x00FFFFFF;
+        _credential_check_dns.addr = 0;
+        if(!_esp8266_ssid_framework_parse_ip(ip_str, &_credential_check_ip.ip) ||
+            !_esp8266_ssid_framework_parse_ip(gateway_str, &_credential_check_ip.gw) ||
+            (netmask_str[0] != '\0' && !_esp8266_ssid_framework_parse_ip(netmask_str, &_credential_check_ip.netmask)) ||
+            (dns_str[0] != '\0' && !_esp8266_ssid_framework_parse_ip(dns_str, &_credential_check_dns)))
+        {
+            os_strcpy(_config_page_status, "Invalid IP settings (IP and gateway needed for static IP)");
+            _esp8266_ssid_framework_generate_config_page();
+            return;
+        }
+    }
+    else if(_credential_check_ip_mode == ESP8266_SSID_FRAMEWORK_IP_MODE_STATIC)
+    {
+        //STATIC IP CLEARED ON THE CONFIG PAGE
+        _credential_check_ip_mode = ESP8266_SSID_FRAMEWORK_IP_MODE_DHCP;
+    }
+
+    os_memset(&_credential_check_config, 0, sizeof(struct station_config));
+    strncpy((char*)_credential_check_config.ssid, ssid, ESP8266_SSID_FRAMEWORK_SSID_NAME_LEN);
+    strncpy((char*)_credential_check_config.password, pswd, ESP8266_SSID_FRAMEWORK_SSID_PSWD_LEN);
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_PORTAL_BENCH
+    if(_bench_active)
+    {
+        //BENCHMARK DRY RUN. STOP BEFORE THE CREDENTIAL CHECK
+        return;
+    }
+#endif
+
+    os_printf("ESP8266 : SSID FRAMEWORK : SSID name : %s\n", ssid);
+#if ESP8266_SSID_FRAMEWORK_PRINT_SECRETS
+    if(_esp8266_ssid_framework_debug)
+    {
+        os_printf("ESP8266 : SSID FRAMEWORK : SSID passsword : %s\n", pswd);
+    }
+#endif
+    os_printf("ESP8266 : SSID FRAMEWORK : Checking SSID credentials ...\n");
+
+    //CHECK THE CREDENTIALS BEFORE CLOSING THE PORTAL
+    _esp8266_ssid_framework_event_post(ESP8266_SSID_FRAMEWORK_EVENT_CREDENTIALS_RECEIVED, 0, NULL, NULL);
+    _esp8266_ssid_framework_credential_check_start();
+}
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_PORTAL_BENCH
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_bench_request(char* request)
+{
+    //BUILD THE RECORDED CONFIG FORM POST (HEADER + URL ENCODED BODY) THE
+    //BENCHMARK REPLAYS. EVERY CUSTOM FIELD GETS A VALID VALUE FOR ITS TYPE
+
+    ESP8266_SSID_FRAMEWORK_CONFIG_USER_FIELD* field;
+    char* body = request + 200;
+    uint16_t body_len;
+    uint16_t header_len;
+    uint8_t i;
+
+    os_strcpy(body, "ssid=BenchNet&password=bench%21pass&ip=&netmask=&gateway=&dns=");
+    for(i = 0; _custom_user_field_group != NULL && i < _custom_user_field_group->custom_fields_count; i++)
+    {
+        field = _custom_user_field_group->custom_fields + i;
+        body_len = os_strlen(body);
+        switch(field->custom_field_type)
+        {
+            case ESP8266_SSID_FRAMEWORK_FIELD_INT:
+                os_sprintf(&body[body_len], "&%s=%d", field->custom_field_name, field->custom_field_min);
+                break;
+            case ESP8266_SSID_FRAMEWORK_FIELD_BOOL:
+                os_sprintf(&body[body_len], "&%s=1", field->custom_field_name);
+                break;
+            case ESP8266_SSID_FRAMEWORK_FIELD_IPV4:
+                os_sprintf(&body[body_len], "&%s=192.168.4.2", field->custom_field_name);
+                break;
+            case ESP8266_SSID_FRAMEWORK_FIELD_ENUM:
+                os_sprintf(&body[body_len], "&%s=0", field->custom_field_name);
+                break;
+            default:
+                os_sprintf(&body[body_len], "&%s=b", field->custom_field_name);
+                break;
+        }
+    }
+
+    body_len = os_strlen(body);
+    header_len = os_sprintf(request, "POST " ESP8266_SSID_FRAMEWORK_WEBCONFIG_PATH_STRING " HTTP/1.1\r\n"
+                                     "Host: 192.168.4.1\r\n"
+                                     "Content-Type: application/x-www-form-urlencoded\r\n"
+                                     "Content-Length: %u\r\n\r\n", body_len);
+    os_memmove(&request[header_len], body, body_len + 1);
+}
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_bench_measure(ESP8266_SSID_FRAMEWORK_BENCH_KIND kind, char* request, uint8_t iterations, ESP8266_SSID_FRAMEWORK_BENCH_STATS* stats)
+{
+    //RUN ONE REQUEST KIND iterations TIMES AND FILL ITS STATS
+
+    uint32_t latency_us[ESP8266_SSID_FRAMEWORK_BENCH_MAX_ITERATIONS];
+    uint16_t len = os_strlen(request);
+    uint16_t header_len = (char*)os_strstr(request, "\r\n\r\n") + 4 - request;
+    uint16_t pos;
+    uint16_t fragment;
+    uint32_t start_us;
+    uint32_t temp;
+    uint8_t i;
+    uint8_t j;
+
+    for(i = 0; i < iterations; i++)
+    {
+        system_soft_wdt_feed();
+        _bench_bytes_copied = 0;
+        _bench_allocations = 0;
+        _bench_peak_heap = 0;
+        _bench_peak_arena = 0;
+        _bench_heap_base = system_get_free_heap_size();
+        _bench_arena_base = _session_arena_stats.in_use;
+        start_us = system_get_time();
+
+        switch(kind)
+        {
+            case ESP8266_SSID_FRAMEWORK_BENCH_GET:
+                //THE SERVER ANSWERS WITH THE PAGE BUFFER. MEASURE WHAT BUILDS IT
+                _esp8266_ssid_framework_tcp_server_path_config_cb();
+                _esp8266_ssid_framework_generate_config_page();
+                break;
+
+            case ESP8266_SSID_FRAMEWORK_BENCH_POST:
+                _esp8266_ssid_framework_tcp_server_post_data_cb(request, len, 1);
+                break;
+
+            case ESP8266_SSID_FRAMEWORK_BENCH_POST_FRAGMENTED:
+                _esp8266_ssid_framework_tcp_server_post_data_cb(request, header_len, 1);
+                for(pos = header_len; pos < len; pos += fragment)
+                {
+                    fragment = len - pos;
+                    if(fragment > ESP8266_SSID_FRAMEWORK_BENCH_FRAGMENT_LEN)
+                    {
+                        fragment = ESP8266_SSID_FRAMEWORK_BENCH_FRAGMENT_LEN;
+                    }
+                    _esp8266_ssid_framework_tcp_server_post_data_cb(&request[pos], fragment, 0);
+                }
+                break;
+        }
+
+        latency_us[i] = system_get_time() - start_us;
+        //HEAP STILL HELD WHEN THE REQUEST IS DONE (E.G. A REASSEMBLY BUFFER)
+        _esp8266_ssid_framework_bench_sample_memory();
+        if(_bench_bytes_copied > stats->bytes_copied)
+        {
+            stats->bytes_copied = _bench_bytes_copied;
+        }
+        if(_bench_allocations > stats->allocations)
+        {
+            stats->allocations = _bench_allocations;
+        }
+        if(_bench_peak_heap > stats->peak_heap)
+        {
+            stats->peak_heap = _bench_peak_heap;
+        }
+        if(_bench_peak_arena > stats->peak_arena)
+        {
+            stats->peak_arena = _bench_peak_arena;
+        }
+    }
+
+    //SORT (INSERTION, AT MOST BENCH_MAX_ITERATIONS) FOR THE PERCENTILES
+    for(i = 1; i < iterations; i++)
+    {
+        temp = latency_us[i];
+        for(j = i; j > 0 && latency_us[j - 1] > temp; j--)
+        {
+            latency_us[j] = latency_us[j - 1];
+        }
+        latency_us[j] = temp;
+    }
+    stats->p50_us = latency_us[(iterations * 50) / 100];
+    stats->p90_us = latency_us[(iterations * 90) / 100];
+    stats->p99_us = latency_us[(iterations * 99) / 100];
+    stats->max_us = latency_us[iterations - 1];
+}
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_bench_sample_memory(void)
+{
+    //UPDATE THE PEAK HEAP AND PEAK ARENA USE OF THE CURRENT BENCHMARK REQUEST
+
+    uint32_t heap = system_get_free_heap_size();
+
+    if(heap < _bench_heap_base && _bench_heap_base - heap > _bench_peak_heap)
+    {
+        _bench_peak_heap = _bench_heap_base - heap;
+    }
+    if(_session_arena_stats.in_use > _bench_arena_base &&
+        _session_arena_stats.in_use - _bench_arena_base > _bench_peak_arena)
+    {
+        _bench_peak_arena = _session_arena_stats.in_use - _bench_arena_base;
+    }
+}
+#endif
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_OTA
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_ota_begin(char* data, uint16_t len)
+{
+    //START A FIRMWARE UPLOAD
+    //PICK THE INACTIVE PARTITION FROM THE FLASH MAP AND PASS ON THE BODY BYTES
+    //THAT CAME WITH THE REQUEST HEADER
+
+    uint32_t max_len;
+    uint32_t param_addr = (uint32_t)_param_sector * SPI_FLASH_SEC_SIZE;
+    uint8_t crc_given;
+    uint8_t user2 = (system_upgrade_userbin_check() == UPGRADE_FW_BIN1);
+    char* body = (char*)os_strstr(data, "\r\n\r\n");
+
+    if(_esp8266_ssid_framework_state != ESP8266_SSID_FRAMEWORK_STATE_PROVISIONING)
+    {
+        if(_esp8266_ssid_framework_debug)
+        {
+            os_printf("ESP8266 : SSID FRAMEWORK : Credential check busy. Firmware upload ignored\n");
+        }
+        return;
+    }
+
+    if(body == NULL || !_esp8266_ssid_framework_header_value(data, "Content-Length", 0, &_ota_expected_len) || _ota_expected_len == 0)
+    {
+        os_strcpy(_config_page_status, "Firmware update failed : no image length");
+        _esp8266_ssid_framework_generate_config_page();
+        return;
+    }
+
+    //INACTIVE PARTITION OF THE FLASH MAP
+    if(!_esp8266_ssid_framework_image_region(user2, &_ota_addr, &max_len))
+    {
+        //NO SECOND PARTITION
+        max_len = 0;
+    }
+
+    _ota_active = 1;
+    _ota_failed = 0;
+    _ota_received = 0;
+    _ota_written = 0;
+    _ota_buffer_len = 0;
+    _ota_crc = 0xFFFFFFFF;
+    crc_given = _esp8266_ssid_framework_header_value(data, "X-Firmware-CRC32", 1, &_ota_expected_crc);
+    _ota_start_us = system_get_time();
+    os_memset(&_ota_stats, 0, sizeof(ESP8266_SSID_FRAMEWORK_OTA_STATS));
+    _ota_stats.image_len = _ota_expected_len;
+    _ota_stats.min_free_heap = system_get_free_heap_size();
+
+    os_timer_disarm(&_ota_idle_timer);
+    os_timer_setfn(&_ota_idle_timer, _esp8266_ssid_framework_ota_idle_timer_cb, NULL);
+    os_timer_arm(&_ota_idle_timer, ESP8266_SSID_FRAMEWORK_OTA_IDLE_TIMEOUT_MS, 0);
+
+    if(_esp8266_ssid_framework_debug)
+    {
+        os_printf("ESP8266 : SSID FRAMEWORK : Firmware upload %u bytes -> 0x%X (user%u)\n", _ota_expected_len, _ota_addr, user2 ? 2 : 1);
+    }
+
+    if(!_esp8266_ssid_framework_ota_key_matches(data))
+    {
+        //THE SOFTAP PASSWORD IS PUBLIC. ONLY THE OTA KEY AUTHORIZES AN UPLOAD
+        _esp8266_ssid_framework_ota_fail("wrong or missing update key");
+    }
+    else if(!crc_given)
+    {
+        //NO CHECKSUM, NO FLASHING. THE IMAGE IS ONLY ACCEPTED IF IT VERIFIES
+        _esp8266_ssid_framework_ota_fail("no X-Firmware-CRC32 header");
+    }
+    else if(max_len == 0)
+    {
+        _esp8266_ssid_framework_ota_fail("flash map has no OTA partition");
+    }
+    else if(_ota_expected_len > max_len)
+    {
+        _esp8266_ssid_framework_ota_fail("image too large");
+    }
+    else if(_param_sector != 0 && _ota_addr < param_addr + 3 * SPI_FLASH_SEC_SIZE &&
+            _ota_addr + _ota_expected_len > param_addr)
+    {
+        //THE PARAMETER RECORD SITS OUTSIDE BOTH IMAGES (SEE param_sector). NEVER
+        //LET AN UPLOAD ERASE IT ANYWAY, THE NEXT SAVE WOULD CORRUPT THE IMAGE
+        _esp8266_ssid_framework_ota_fail("image would overwrite the parameter record");
+    }
+    else
+    {
+        system_upgrade_flag_set(UPGRADE_FLAG_START);
+    }
+
+    body += 4;
+    _esp8266_ssid_framework_ota_write((uint8_t*)body, len - (body - data));
+}
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_ota_write(uint8_t* data, uint16_t len)
+{
+    //STREAM UPLOAD BYTES INTO THE ALIGNED WRITE BUFFER
+    //A FULL BUFFER IS WRITTEN OUT, THE IMAGE IS NEVER HELD IN RAM
+
+    uint32_t heap = system_get_free_heap_size();
+    uint16_t n;
+
+    os_timer_disarm(&_ota_idle_timer);
+    os_timer_arm(&_ota_idle_timer, ESP8266_SSID_FRAMEWORK_OTA_IDLE_TIMEOUT_MS, 0);
+
+    if(heap < _ota_stats.min_free_heap)
+    {
+        _ota_stats.min_free_heap = heap;
+    }
+
+    //IGNORE ANYTHING PAST CONTENT LENGTH
+    if(len > _ota_expected_len - _ota_received)
+    {
+        len = _ota_expected_len - _ota_received;
+    }
+    _ota_received += len;
+
+    //USER BIN IMAGES START WITH 0xEA
+    if(!_ota_failed && _ota_written == 0 && _ota_buffer_len == 0 && len != 0 && data[0] != 0xEA)
+    {
+        _esp8266_ssid_framework_ota_fail("not a user bin image");
+    }
+
+    while(len != 0 && !_ota_failed)
+    {
+        n = ESP8266_SSID_FRAMEWORK_OTA_WRITE_CHUNK - _ota_buffer_len;
+        if(n > len)
+        {
+            n = len;
+        }
+        os_memcpy((uint8_t*)_ota_buffer + _ota_buffer_len, data, n);
+        _ota_buffer_len += n;
+        data += n;
+        len -= n;
+
+        if(_ota_buffer_len == ESP8266_SSID_FRAMEWORK_OTA_WRITE_CHUNK)
+        {
+            _esp8266_ssid_framework_ota_flush();
+        }
+    }
+
+    if(_ota_received >= _ota_expected_len)
+    {
+        if(!_ota_failed && _ota_buffer_len != 0)
+        {
+            _esp8266_ssid_framework_ota_flush();
+        }
+        _esp8266_ssid_framework_ota_end();
+    }
+}
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_ota_flush(void)
+{
+    //WRITE THE BUFFER TO FLASH (ERASING EACH SECTOR AS IT IS ENTERED)
+    //READ IT BACK, COMPARE AND ADD IT TO THE IMAGE CRC
+
+    uint32_t addr = _ota_addr + _ota_written;
+    uint16_t len = (_ota_buffer_len + 3) & ~3;
+
+    //PAD THE LAST PARTIAL WORD
+    os_memset((uint8_t*)_ota_buffer + _ota_buffer_len, 0xFF, len - _ota_buffer_len);
+
+    if((addr % SPI_FLASH_SEC_SIZE) == 0 && spi_flash_erase_sector(addr / SPI_FLASH_SEC_SIZE) != SPI_FLASH_RESULT_OK)
+    {
+        _esp8266_ssid_framework_ota_fail("flash erase failed");
+        return;
+    }
+
+    if(spi_flash_write(addr, _ota_buffer, len) != SPI_FLASH_RESULT_OK ||
+        spi_flash_read(addr, _ota_verify_buffer, len) != SPI_FLASH_RESULT_OK ||
+        os_memcmp(_ota_buffer, _ota_verify_buffer, len) != 0)
+    {
+        _esp8266_ssid_framework_ota_fail("flash write failed");
+        return;
+    }
+
+    _ota_crc = _esp8266_ssid_framework_crc32_update(_ota_crc, (uint8_t*)_ota_verify_buffer, _ota_buffer_len);
+    _ota_written += _ota_buffer_len;
+    _ota_buffer_len = 0;
+}
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_ota_fail(char* message)
+{
+    //MARK THE UPLOAD AS FAILED. REMAINING BYTES ARE DROPPED UNTIL IT ENDS
+
+    if(_ota_failed)
+    {
+        return;
+    }
+    _ota_failed = 1;
+    os_sprintf(_config_page_status, "Firmware update failed : %s", message);
+
+    if(_esp8266_ssid_framework_debug)
+    {
+        os_printf("ESP8266 : SSID FRAMEWORK : Firmware update failed (%s)\n", message);
+    }
+}
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_ota_end(void)
+{
+    //ALL BYTES RECEIVED (OR UPLOAD ABORTED)
+    //CHECK THE CRC AND SWITCH THE BOOT PARTITION
+
+    os_timer_disarm(&_ota_idle_timer);
+    _ota_active = 0;
+
+    _ota_stats.duration_ms = (system_get_time() - _ota_start_us) / 1000;
+    if(_ota_stats.duration_ms != 0)
+    {
+        _ota_stats.bytes_per_s = (_ota_received * 1000) / _ota_stats.duration_ms;
+    }
+
+    _ota_crc ^= 0xFFFFFFFF;
+    if(!_ota_failed && _ota_received < _ota_expected_len)
+    {
+        _esp8266_ssid_framework_ota_fail("upload interrupted");
+    }
+    if(!_ota_failed && _ota_crc != _ota_expected_crc)
+    {
+        _esp8266_ssid_framework_ota_fail("checksum mismatch");
+    }
+
+    if(_esp8266_ssid_framework_debug)
+    {
+        os_printf("ESP8266 : SSID FRAMEWORK : Firmware upload %u bytes in %u ms (%u B/s) | crc %08X | min free heap %u\n",
+                    _ota_received, _ota_stats.duration_ms, _ota_stats.bytes_per_s, _ota_crc, _ota_stats.min_free_heap);
+    }
+
+    if(_ota_failed)
+    {
+        system_upgrade_flag_set(UPGRADE_FLAG_IDLE);
+    }
+    else
+    {
+        os_sprintf(_config_page_status, "Firmware updated (%u bytes, %u B/s). Rebooting ...", _ota_received, _ota_stats.bytes_per_s);
+        system_upgrade_flag_set(UPGRADE_FLAG_FINISH);
+
+        //REBOOT ONCE THE RESULT PAGE HAS BEEN SERVED
+        os_timer_disarm(&_ota_reboot_timer);
+        os_timer_setfn(&_ota_reboot_timer, _esp8266_ssid_framework_ota_reboot_timer_cb, NULL);
+        os_timer_arm(&_ota_reboot_timer, ESP8266_SSID_FRAMEWORK_OTA_REBOOT_DELAY_MS, 0);
+    }
+
+    _esp8266_ssid_framework_generate_config_page();
+}
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_ota_idle_timer_cb(void* pArg)
+{
+    //NO UPLOAD DATA FOR IDLE TIMEOUT. CONNECTION IS GONE
+
+    if(_ota_active)
+    {
+        _esp8266_ssid_framework_ota_end();
+    }
+}
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_ota_reboot_timer_cb(void* pArg)
+{
+    //BOOT INTO THE NEW FIRMWARE
+
+    system_upgrade_reboot();
+}
+#endif
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_credential_check_start(void)
+{
+    //CHECK THE SUBMITTED CREDENTIALS WHILE THE PORTAL STAYS UP
+    //STEP 1 : TARGETED SCAN FOR THE SSID (PRESENCE + AUTH MODE)
+    //STEP 2 : TRIAL ASSOCIATION IN STATION+SOFTAP MODE UNTIL GOT IP
+
+    struct scan_config scan;
+
+    _esp8266_ssid_framework_state = ESP8266_SSID_FRAMEWORK_STATE_CHECKING_CREDENTIALS;
+    os_sprintf(_config_page_status, "Checking network %s ...", _credential_check_config.ssid);
+    _esp8266_ssid_framework_generate_config_page();
+
+    //ENABLE STATION INTERFACE ALONGSIDE THE SOFTAP
+    //NOTE : ONCE ASSOCIATED, THE SOFTAP FOLLOWS THE CHANNEL OF THE TARGET AP
+    //(MOVED AHEAD OF THE ASSOCIATION IN THE SCAN DONE CB)
+    wifi_set_opmode_current(STATIONAP_MODE);
+    wifi_station_set_auto_connect(FALSE);
+    wifi_station_set_reconnect_policy(FALSE);
+
+    //ARM THE CREDENTIAL CHECK TIMER (COVERS SCAN + ASSOCIATION)
+    os_timer_disarm(&_credential_check_timer);
+    os_timer_setfn(&_credential_check_timer, _esp8266_ssid_framework_credential_check_timer_cb, NULL);
+    os_timer_arm(&_credential_check_timer, ESP8266_SSID_FRAMEWORK_CREDENTIAL_CHECK_TIMEOUT_MS, 0);
+    os_timer_disarm(&_credential_retry_timer);
+    os_timer_setfn(&_credential_retry_timer, _esp8266_ssid_framework_credential_retry_timer_cb, NULL);
+
+    os_memset(&scan, 0, sizeof(struct scan_config));
+    scan.ssid = _credential_check_config.ssid;
+    scan.show_hidden = 1;
+    if(!wifi_station_scan(&scan, _esp8266_ssid_framework_credential_check_scan_done_cb))
+    {
+        _esp8266_ssid_framework_credential_check_finish(0, "Scan could not be started");
+    }
+}
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_credential_check_scan_done_cb(void* arg, STATUS status)
+{
+    //CB FUNCTION FOR TARGETED SSID SCAN DONE
+
+    if(_esp8266_ssid_framework_state != ESP8266_SSID_FRAMEWORK_STATE_CHECKING_CREDENTIALS)
+    {
+        //CHECK ALREADY TIMED OUT
+        return;
+    }
+
+    if(status != OK)
+    {
+        _esp8266_ssid_framework_credential_check_finish(0, "Scan failed");
+        return;
+    }
+
+    //PICK THE STRONGEST AP ADVERTISING THE SSID
+    struct bss_info* bss = (struct bss_info*)arg;
+    struct bss_info* best = NULL;
+    struct softap_config softap;
+    while(bss != NULL)
+    {
+        if(os_strncmp((char*)bss->ssid, (char*)_credential_check_config.ssid, ESP8266_SSID_FRAMEWORK_SSID_NAME_LEN) == 0)
+        {
+            if(best == NULL || bss->rssi > best->rssi)
+            {
+                best = bss;
+            }
+        }
+        bss = STAILQ_NEXT(bss, next);
+    }
+
+    if(best == NULL)
+    {
+        _esp8266_ssid_framework_credential_check_finish(0, "Network not found");
+        return;
+    }
+
+    if(_esp8266_ssid_framework_debug)
+    {
+        os_printf("ESP8266 : SSID FRAMEWORK : SSID found. Channel %u | RSSI %d | Auth %u\n", best->channel, best->rssi, best->authmode);
+    }
+
+    if(best->authmode == AUTH_OPEN)
+    {
+        //OPEN NETWORK. PASSWORD NOT USED
+        os_memset(_credential_check_config.password, 0, ESP8266_SSID_FRAMEWORK_SSID_PSWD_LEN);
+    }
+    else if(best->authmode != AUTH_WEP && os_strlen((char*)_credential_check_config.password) < 8)
+    {
+        _esp8266_ssid_framework_credential_check_finish(0, "Password too short for WPA/WPA2 network");
+        return;
+    }
+
+    //MOVE THE SOFTAP TO THE TARGET AP CHANNEL BEFORE ASSOCIATING. THE BROWSER
+    //IS DROPPED ONCE HERE AND REJOINS WHILE THE CHECK RUNS, INSTEAD OF BEING
+    //DROPPED BY THE ASSOCIATION RIGHT WHEN THE RESULT IS READY
+    wifi_softap_get_config(&softap);
+    if(softap.channel != best->channel)
+    {
+        softap.channel = best->channel;
+        wifi_softap_set_config_current(&softap);
+    }
+
+    //TRIAL ASSOCIATION (NOT SAVED TO FLASH UNTIL IT WORKS)
+    wifi_station_set_config_current(&_credential_check_config);
+    _esp8266_ssid_framework_ip_apply(_credential_check_ip_mode, &_credential_check_ip, &_credential_check_dns, _credential_check_config.ssid);
+    wifi_station_connect();
+}
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_credential_check_timer_cb(void* pArg)
+{
+    //CREDENTIAL CHECK TIMER CB FUNCTION
+
+    if(_esp8266_ssid_framework_state == ESP8266_SSID_FRAMEWORK_STATE_CHECKING_CREDENTIALS && !_portal_teardown_pending)
+    {
+        _esp8266_ssid_framework_credential_check_finish(0, "Timed out");
+    }
+}
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_credential_retry_timer_cb(void* pArg)
+{
+    //CREDENTIAL RETRY TIMER CB FUNCTION
+    //REASSOCIATE AFTER A NON TERMINAL DISCONNECT DURING THE CHECK
+
+    if(_esp8266_ssid_framework_state == ESP8266_SSID_FRAMEWORK_STATE_CHECKING_CREDENTIALS && !_portal_teardown_pending)
+    {
+        wifi_station_connect();
+    }
+}
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_credential_check_finish(uint8_t success, char* message)
+{
+    //END THE CREDENTIAL CHECK AND REPORT THE RESULT ON THE CONFIG PAGE
+    //SUCCESS : KEEP THE LINK, CLOSE THE PORTAL TEARDOWN DELAY AFTER THE RESULT
+    //          PAGE HAS BEEN SERVED (OR AFTER RESULT GRACE IF NOBODY LOADS IT)
+    //FAILURE : DROP THE STATION INTERFACE, PORTAL STAYS UP FOR ANOTHER TRY
+
+    os_timer_disarm(&_credential_check_timer);
+    os_timer_disarm(&_credential_retry_timer);
+
+    if(success)
+    {
+        os_sprintf(_config_page_status, "Connected to %s. Closing config portal ...", _credential_check_config.ssid);
+
+        _portal_teardown_pending = 1;
+        _portal_result_served = 0;
+        os_timer_disarm(&_portal_teardown_timer);
+        os_timer_setfn(&_portal_teardown_timer, _esp8266_ssid_framework_portal_teardown_timer_cb, NULL);
+        os_timer_arm(&_portal_teardown_timer, ESP8266_SSID_FRAMEWORK_PORTAL_RESULT_GRACE_MS, 0);
+    }
+    else
+    {
+        os_sprintf(_config_page_status, "Could not connect to %s : %s", _credential_check_config.ssid, message);
+
+        wifi_station_disconnect();
+        wifi_set_opmode_current(SOFTAP_MODE);
+        _esp8266_ssid_framework_state = ESP8266_SSID_FRAMEWORK_STATE_PROVISIONING;
+    }
+
+    if(_esp8266_ssid_framework_debug)
+    {
+        os_printf("ESP8266 : SSID FRAMEWORK : Credential check %s (%s)\n", success ? "passed" : "failed", message);
+    }
+
+    _esp8266_ssid_framework_generate_config_page();
+}
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_portal_teardown_timer_cb(void* pArg)
+{
+    //CLOSE THE CONFIG PORTAL AFTER A SUCCESSFULL CREDENTIAL CHECK
+
+    uint8_t changed = 0;
+
+    _portal_teardown_pending = 0;
+
+    //STOP MDNS
+    ESP8266_MDNS_Stop();
+
+    //STOP TCP SERVER
+    ESP8266_TCP_SERVER_Stop();
+
+    //FREE MEMORY
+    _esp8266_ssid_framework_arena_release();
+
+    wifi_softap_dhcps_stop();
+    wifi_set_opmode(STATION_MODE);
+
+    //DEPENDING ON INPUT MODE, SAVE THE CREDENTIALS
+    if(_input_mode == ESP8266_SSID_FRAMEWORK_SSID_INPUT_HARDCODED ||
+        _input_mode == ESP8266_SSID_FRAMEWORK_SSID_INPUT_GPIO ||
+        _input_mode == ESP8266_SSID_FRAMEWORK_SSID_INPUT_INTERNAL)
+    {
+#if ESP8266_SSID_FRAMEWORK_MODULE_CREDENTIAL_CRYPT
+        //ENCRYPTED INTO THE PARAMETER RECORD (SAVED BELOW). THE SDK ONLY GETS
+        //THE CURRENT CONFIG, SO IT KEEPS NO PLAINTEXT COPY IN FLASH
+        changed = _esp8266_ssid_framework_credential_store(&_credential_check_config);
+        wifi_station_set_config_current(&_credential_check_config);
+#else
+        //LET THE ESP8266 CACHE THE CREDENTIALS INTERNALLY
+        wifi_station_set_config(&_credential_check_config);
+#endif
+    }
+
+    //SAVE THE IP SETTINGS AND CUSTOM FIELD VALUES THAT CAME WITH THE CREDENTIALS
+    //ONE FLASH WRITE FOR BOTH, ONLY IF SOMETHING CHANGED
+    changed |= _esp8266_ssid_framework_ip_config_store(_credential_check_ip_mode, &_credential_check_ip, &_credential_check_dns);
+    if(_param_record.custom_signature != _custom_field_signature ||
+        _param_record.custom_present != _credential_check_custom_present ||
+        os_memcmp(_param_record.custom_values, _credential_check_custom_values, ESP8266_SSID_FRAMEWORK_CUSTOM_FIELD_STORE_LEN) != 0)
+    {
+        _param_record.custom_signature = _custom_field_signature;
+        _param_record.custom_present = _credential_check_custom_present;
+        os_memcpy(_param_record.custom_values, _credential_check_custom_values, ESP8266_SSID_FRAMEWORK_CUSTOM_FIELD_STORE_LEN);
+        changed = 1;
+    }
+    if(changed)
+    {
+        _esp8266_ssid_framework_param_save();
+    }
+    _esp8266_ssid_framework_custom_fields_publish();
+
+    if(wifi_station_get_connect_status() == STATION_GOT_IP)
+    {
+        _esp8266_ssid_framework_wifi_on_connected();
+    }
+    else
+    {
+        //LINK LOST WHILE THE PORTAL WAS CLOSING. USE THE NORMAL CONNECTION PROCESS
+        _esp8266_ssid_framework_wifi_start_connection_process(&_credential_check_config);
+    }
+}
+#endif
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_wifi_on_connected(void)
+{
+    //DEVICE CONNECTED TO WIFI. CALL USER CB FUNCTION
+    //TO START THE APPLICATION
+    //CALL USER CB IF NOT NULL
+
+    _esp8266_ssid_framework_state = ESP8266_SSID_FRAMEWORK_STATE_CONNECTED;
+    os_timer_disarm(&_wifi_connect_timer);
+    os_timer_disarm(&_supervisor_reconnect_timer);
+
+    //STOP STATUS LED TOGGLING
+    os_timer_disarm(&_status_led_timer);
+    //TURN OFF LED
+    ESP8266_GPIO_Set_Value(_led_gpio_pin, 0);
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_STATION_MDNS
+    //ANNOUNCE THE DEVICE ON THE NETWORK
+    _esp8266_ssid_framework_mdns_start();
+#endif
+
+    //START LINK SUPERVISION
+    _esp8266_ssid_framework_supervisor_start();
+#if ESP8266_SSID_FRAMEWORK_MODULE_ROAMING
+    if(_roam_enabled)
+    {
+        _esp8266_ssid_framework_roam_start();
+    }
+#endif
+
+    //USER CB FUNCTIONS ARE CALLED FROM THE EVENT TASK
+    struct ip_info info;
+    wifi_get_ip_info(STATION_IF, &info);
+    _esp8266_ssid_framework_event_post(ESP8266_SSID_FRAMEWORK_EVENT_CONNECTED, 0, NULL, &info.ip);
+}
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_supervisor_start(void)
+{
+    //START PERIODIC GATEWAY PROBING FOR THE CURRENT LINK
+
+    _supervisor_probe_fails = 0;
+    _supervisor_gateway_replied = 0;
+
+    os_timer_disarm(&_supervisor_probe_timer);
+    if(_supervisor_probe_interval_ms != 0)
+    {
+        os_timer_setfn(&_supervisor_probe_timer, _esp8266_ssid_framework_supervisor_probe_timer_cb, NULL);
+        os_timer_arm(&_supervisor_probe_timer, _supervisor_probe_interval_ms, 1);
+    }
+}
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_supervisor_link_lost(uint8_t reason)
+{
+    //WIFI LINK LOST (OR STALE) AFTER BEING CONNECTED
+    //NOTIFY USER AND START RECONNECTING WITH BACKOFF
+
+    if(_esp8266_ssid_framework_state != ESP8266_SSID_FRAMEWORK_STATE_CONNECTED)
+    {
+        return;
+    }
+
+    if(_esp8266_ssid_framework_debug)
+    {
+        os_printf("ESP8266 : SSID FRAMEWORK : Link lost (reason %u). Recovering\n", reason);
+    }
+
+    _esp8266_ssid_framework_state = ESP8266_SSID_FRAMEWORK_STATE_RECOVERING;
+    _esp8266_ssid_framework_wifi_connected = 0;
+    os_timer_disarm(&_supervisor_probe_timer);
+#if ESP8266_SSID_FRAMEWORK_MODULE_STATION_MDNS
+    _esp8266_ssid_framework_mdns_stop();
+#endif
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_ROAMING
+    //DO NOT STAY LOCKED TO A ROAMED BSSID WHILE RECOVERING
+    os_timer_disarm(&_roam_sample_timer);
+    struct station_config config;
+    wifi_station_get_config(&config);
+    if(config.bssid_set)
+    {
+        config.bssid_set = 0;
+        wifi_station_set_config_current(&config);
+    }
+#endif
+
+    //START STATUS LED TOGGLING AGAIN
+    os_timer_arm(&_status_led_timer, 250, 1);
+
+    _supervisor_outage_ms = 0;
+    _supervisor_backoff_ms = ESP8266_SSID_FRAMEWORK_RECONNECT_BACKOFF_MIN_MS;
+    os_timer_disarm(&_supervisor_reconnect_timer);
+    os_timer_setfn(&_supervisor_reconnect_timer, _esp8266_ssid_framework_supervisor_reconnect_timer_cb, NULL);
+    os_timer_arm(&_supervisor_reconnect_timer, _supervisor_backoff_ms, 0);
+
+    _esp8266_ssid_framework_event_post(ESP8266_SSID_FRAMEWORK_EVENT_LINK_LOST, reason, NULL, NULL);
+}
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_supervisor_probe_timer_cb(void* pArg)
+{
+    //GATEWAY PROBE TIMER CB FUNCTION
+    //SEND A SINGLE PING TO THE GATEWAY
+
+    struct ip_info info;
+
+    if(_esp8266_ssid_framework_state != ESP8266_SSID_FRAMEWORK_STATE_CONNECTED)
+    {
+        return;
+    }
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_STATS
+    _esp8266_ssid_framework_stats_sample_rssi();
+#endif
+
+    wifi_get_ip_info(STATION_IF, &info);
+    if(info.gw.addr == 0)
+    {
+        return;
+    }
+
+    os_memset(&_supervisor_ping_option, 0, sizeof(struct ping_option));
+    _supervisor_ping_option.count = 1;
+    _supervisor_ping_option.ip = info.gw.addr;
+    _supervisor_ping_option.coarse_time = 1;
+    ping_regist_recv(&_supervisor_ping_option, _esp8266_ssid_framework_supervisor_ping_recv_cb);
+    ping_start(&_supervisor_ping_option);
+}
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_supervisor_ping_recv_cb(void* arg, void* pdata)
+{
+    //CB FUNCTION FOR GATEWAY PING RESULT
+    //FAILURES ONLY COUNT ONCE THE GATEWAY HAS REPLIED ON THIS LINK, SO
+    //GATEWAYS THAT DROP ICMP DO NOT TRIGGER RECONNECTS
+
+    struct ping_resp* resp = (struct ping_resp*)pdata;
+
+    if(_esp8266_ssid_framework_state != ESP8266_SSID_FRAMEWORK_STATE_CONNECTED)
+    {
+        return;
+    }
+
+    if(resp->ping_err == -1)
+    {
+        if(!_supervisor_gateway_replied)
+        {
+            return;
+        }
+
+        _supervisor_probe_fails++;
+        if(_esp8266_ssid_framework_debug)
+        {
+            os_printf("ESP8266 : SSID FRAMEWORK : Gateway probe failed (%u)\n", _supervisor_probe_fails);
+        }
+
+        if(_supervisor_probe_fails >= ESP8266_SSID_FRAMEWORK_PROBE_FAIL_LIMIT)
+        {
+            //LINK IS STALE. DROP IT AND RECOVER
+            _esp8266_ssid_framework_supervisor_link_lost(ESP8266_SSID_FRAMEWORK_LINK_DOWN_PROBE_FAILED);
+            wifi_station_disconnect();
+        }
+    }
+    else
+    {
+        _supervisor_probe_fails = 0;
+        _supervisor_gateway_replied = 1;
+    }
+}
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_supervisor_reconnect_timer_cb(void* pArg)
+{
+    //LINK RECOVERY TIMER CB FUNCTION
+    //RECONNECT WITH EXPONENTIAL BACKOFF UNTIL THE OUTAGE BUDGET IS USED UP
+
+    if(_esp8266_ssid_framework_state != ESP8266_SSID_FRAMEWORK_STATE_RECOVERING)
+    {
+        return;
+    }
+
+    _supervisor_outage_ms += _supervisor_backoff_ms;
+    if(_supervisor_outage_budget_ms != 0 && _supervisor_outage_ms >= _supervisor_outage_budget_ms)
+    {
+        //OUTAGE BUDGET USED UP
+        if(_esp8266_ssid_framework_debug)
+        {
+            os_printf("ESP8266 : SSID FRAMEWORK : Outage budget used up\n");
+        }
+
+        //START THE SSID CONFIGURATION PROCESS
+        wifi_station_disconnect();
+        _esp8266_ssid_framework_wifi_start_ssid_configuration();
+        return;
+    }
+
+    if(_esp8266_ssid_framework_debug)
+    {
+        os_printf("ESP8266 : SSID FRAMEWORK : Reconnecting (outage %u ms)\n", _supervisor_outage_ms);
+    }
+    struct station_config config;
+    wifi_station_get_config(&config);
+    wifi_station_disconnect();
+    _esp8266_ssid_framework_ip_apply(_param_record.ip_mode, &_param_record.static_ip, &_param_record.static_dns, config.ssid);
+    wifi_station_connect();
+
+    _supervisor_backoff_ms *= 2;
+    if(_supervisor_backoff_ms > ESP8266_SSID_FRAMEWORK_RECONNECT_BACKOFF_MAX_MS)
+    {
+        _supervisor_backoff_ms = ESP8266_SSID_FRAMEWORK_RECONNECT_BACKOFF_MAX_MS;
+    }
+    os_timer_arm(&_supervisor_reconnect_timer, _supervisor_backoff_ms, 0);
+}
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_ROAMING
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_roam_start(void)
+{
+    //START RSSI SAMPLING FOR THE CURRENT LINK
+
+    _roam_rssi_valid = 0;
+    _roam_dwell_ms = 0;
+    _roam_scanning = 0;
+    _roam_in_progress = 0;
+
+    os_timer_disarm(&_roam_sample_timer);
+    os_timer_setfn(&_roam_sample_timer, _esp8266_ssid_framework_roam_sample_timer_cb, NULL);
+    os_timer_arm(&_roam_sample_timer, ESP8266_SSID_FRAMEWORK_ROAM_SAMPLE_INTERVAL_MS, 1);
+}
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_roam_sample_timer_cb(void* pArg)
+{
+    //RSSI SAMPLE TIMER CB FUNCTION
+    //UPDATE MOVING AVERAGE AND START A ROAM SCAN IF THE LINK IS WEAK
+
+    struct scan_config scan;
+    uint8_t i;
+
+    if(_esp8266_ssid_framework_state != ESP8266_SSID_FRAMEWORK_STATE_CONNECTED || _roam_in_progress)
+    {
+        return;
+    }
+
+    int8_t rssi = wifi_station_get_rssi();
+    if(rssi == 31)
+    {
+        //RSSI READ FAILED
+        return;
+    }
+
+    //AVERAGE IS KEPT SCALED BY 2^RSSI_AVG_SHIFT
+    if(!_roam_rssi_valid)
+    {
+        _roam_rssi_avg = (int16_t)rssi << ESP8266_SSID_FRAMEWORK_ROAM_RSSI_AVG_SHIFT;
+        _roam_rssi_valid = 1;
+    }
+    else
+    {
+        _roam_rssi_avg += rssi - (_roam_rssi_avg >> ESP8266_SSID_FRAMEWORK_ROAM_RSSI_AVG_SHIFT);
+    }
+    _roam_dwell_ms += ESP8266_SSID_FRAMEWORK_ROAM_SAMPLE_INTERVAL_MS;
+
+    if(_roam_scanning ||
+        _roam_dwell_ms < ESP8266_SSID_FRAMEWORK_ROAM_MIN_DWELL_MS ||
+        ESP8266_SSID_FRAMEWORK_GetAverageRssi() >= _roam_rssi_threshold)
+    {
+        return;
+    }
+
+    //LINK WEAK. LOOK FOR A BETTER BSSID OF THE SAME SSID
+    wifi_station_get_config(&_roam_station_config);
+    os_memset(&scan, 0, sizeof(struct scan_config));
+    scan.ssid = _roam_station_config.ssid;
+
+    _roam_scan_count++;
+    if(_roam_cache_count != 0 && (_roam_scan_count % ESP8266_SSID_FRAMEWORK_ROAM_FULL_SCAN_EVERY) != 0)
+    {
+        //SINGLE CHANNEL SCAN ON THE BEST CACHED OTHER BSSID'S CHANNEL
+        scan.channel = wifi_get_channel();
+        int8_t best_rssi = -127;
+        for(i = 0; i < _roam_cache_count; i++)
+        {
+            if(os_memcmp(_roam_cache[i].bssid, _roam_current_bssid, 6) != 0 && _roam_cache[i].rssi > best_rssi)
+            {
+                best_rssi = _roam_cache[i].rssi;
+                scan.channel = _roam_cache[i].channel;
+            }
+        }
+    }
+
+    if(_esp8266_ssid_framework_debug)
+    {
+        os_printf("ESP8266 : SSID FRAMEWORK : RSSI avg %d dBm. Roam scan (channel %u)\n", ESP8266_SSID_FRAMEWORK_GetAverageRssi(), scan.channel);
+    }
+
+    _roam_scanning = 1;
+    if(!wifi_station_scan(&scan, _esp8266_ssid_framework_roam_scan_done_cb))
+    {
+        _roam_scanning = 0;
+    }
+}
+
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_roam_scan_done_cb(void* arg, STATUS status)
+{
+    //CB FUNCTION FOR ROAM SCAN DONE
+    //REFRESH BSSID CACHE AND REASSOCIATE IF A BETTER BSSID WAS FOUND
+
+    struct bss_info* bss = (struct bss_info*)arg;
+    struct bss_info* best = NULL;
+    uint8_t i;
+
+    _roam_scanning = 0;
+
+    //BACK OFF FOR ANOTHER DWELL PERIOD WHETHER OR NOT WE ROAM
+    _roam_dwell_ms = 0;
+
+    if(_esp8266_ssid_framework_state != ESP8266_SSID_FRAMEWORK_STATE_CONNECTED || status != OK)
+    {
+        return;
+    }
+
+    while(bss != NULL)
+    {
+        if(os_strncmp((char*)bss->ssid, (char*)_roam_station_config.ssid, ESP8266_SSID_FRAMEWORK_SSID_NAME_LEN) == 0)
+        {
+            //UPDATE CACHE ENTRY (OR REPLACE THE WEAKEST ONE)
+            uint8_t slot = _roam_cache_count;
+            for(i = 0; i < _roam_cache_count; i++)
+            {
+                if(os_memcmp(_roam_cache[i].bssid, bss->bssid, 6) == 0)
+                {
+                    slot = i;
+                    break;
+                }
+            }
+            if(slot == ESP8266_SSID_FRAMEWORK_ROAM_CACHE_COUNT)
+            {
+                slot = 0;
+                for(i = 1; i < _roam_cache_count; i++)
+                {
+                    if(_roam_cache[i].rssi < _roam_cache[slot].rssi)
+                    {
+                        slot = i;
+                    }
+                }
+                if(_roam_cache[slot].rssi >= bss->rssi)
+                {
+                    slot = 0xFF;
+                }
+            }
+            if(slot != 0xFF)
+            {
+                os_memcpy(_roam_cache[slot].bssid, bss->bssid, 6);
+                _roam_cache[slot].channel = bss->channel;
+                _roam_cache[slot].rssi = bss->rssi;
+                if(slot == _roam_cache_count)
+                {
+                    _roam_cache_count++;
+                }
+            }
+
+            if(os_memcmp(bss->bssid, _roam_current_bssid, 6) != 0 && (best == NULL || bss->rssi > best->rssi))
+            {
+                best = bss;
+            }
+        }
+        bss = STAILQ_NEXT(bss, next);
+    }
+
+    if(best == NULL || best->rssi < ESP8266_SSID_FRAMEWORK_GetAverageRssi() + ESP8266_SSID_FRAMEWORK_ROAM_HYSTERESIS_DB)
+    {
+        //NOTHING BETTER BY ENOUGH MARGIN
+        return;
+    }
+
+    if(_esp8266_ssid_framework_debug)
+    {
+        os_printf("ESP8266 : SSID FRAMEWORK : Roaming to %02X:%02X:%02X:%02X:%02X:%02X (channel %u, %d dBm)\n",
+                    best->bssid[0], best->bssid[1], best->bssid[2], best->bssid[3], best->bssid[4], best->bssid[5],
+                    best->channel, best->rssi);
+    }
+
+    //REASSOCIATE LOCKED TO THE NEW BSSID
+    _roam_station_config.bssid_set = 1;
+    os_memcpy(_roam_station_config.bssid, best->bssid, 6);
+    _roam_in_progress = 1;
+    wifi_station_set_config_current(&_roam_station_config);
+    wifi_station_disconnect();
+    wifi_station_connect();
+}
+#endif
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_INPUT_HARDCODED || ESP8266_SSID_FRAMEWORK_MODULE_CREDENTIAL_CRYPT
+static bool _esp8266_ssid_framework_check_valid_stationconfig(struct station_config* config)
+{
+    //CHECK IF PROVIDED STATION CONFIG IS VALID
+
+    if(config->ssid[0] < 48 || config->ssid[0] > 126 || config->password[0] < 48 || config->password[0] > 126)
+        return false;
+    return true;
+}
+#endif
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_CONFIG_WEBCONFIG
+static void ICACHE_FLASH_ATTR _esp8266_ssid_framework_page_append(const char* str)
+{
+    //APPEND STRING TO CONFIG PAGE HTML
+    //LENGTH IS TRACKED SO THE PAGE IS NOT RESCANNED ON EVERY APPEND
+
+    uint16_t len = os_strlen(str);
+
+    if(_config_page_len + len >= ESP8266_SSID_FRAMEWORK_CONFIG_PAGE_LEN)
+    {
+        if(_esp8266_ssid_framework_debug)
+        {
+            os_printf("ESP8266 : SSID FRAMEWORK : Config page buffer full!\n");
+        }
+        return;
+    }
+    os_memcpy(&_config_page_html[_config_page_len], str, len + 1);
+    _config_page_len += len;
+#if ESP8266_SSID_FRAMEWORK_MODULE_PORTAL_BENCH
+    _bench_bytes_copied += len + 1;
+#endif
+}
+#endif
+
+static bool ICACHE_FLASH_ATTR _esp8266_ssid_framework_reason_is_terminal(uint8_t reason)
+{
+    //CHECK IF WIFI DISCONNECT REASON IS TERMINAL
+    //TERMINAL = RETRYING WITH THE SAME CREDENTIALS WILL NOT HELP
+
+    switch(reason)
+    {
+        case REASON_AUTH_FAIL:
+        case REASON_4WAY_HANDSHAKE_TIMEOUT:
+        case REASON_HANDSHAKE_TIMEOUT:
+            return true;
+        case REASON_NO_AP_FOUND:
+            return ESP8266_SSID_FRAMEWORK_NO_AP_FOUND_IS_TERMINAL;
+        default:
+            return false;
+    }
+}
+
+static const char* ICACHE_FLASH_ATTR _esp8266_ssid_framework_reason_string(uint8_t reason)
+{
+    //RETURN READABLE STRING FOR WIFI DISCONNECT REASON
+
+    switch(reason)
+    {
+        case REASON_AUTH_FAIL:
+        case REASON_4WAY_HANDSHAKE_TIMEOUT:
+        case REASON_HANDSHAKE_TIMEOUT:
+            return "Wrong password";
+        case REASON_NO_AP_FOUND:
+            return "Network not found";
+        case REASON_BEACON_TIMEOUT:
+            return "Beacon timeout";
+        case REASON_ASSOC_FAIL:
+            return "Association failed";
+        case REASON_AUTH_EXPIRE:
+            return "Authentication expired";
+        case REASON_ASSOC_LEAVE:
+            return "Left network";
+        default:
+            return "Connection failed";
+    }
+}
+
+static uint8_t ICACHE_FLASH_ATTR _esp8266_ssid_framework_reason_slot(uint8_t reason)
+{
+    //MAP WIFI DISCONNECT REASON CODE TO COUNTER SLOT
+
+    if(reason >= 1 && reason <= 24)
+    {
+        return reason;
+    }
+    if(reason >= REASON_BEACON_TIMEOUT && reason <= REASON_HANDSHAKE_TIMEOUT)
+    {
+        return 25 + (reason - REASON_BEACON_TIMEOUT);
+    }
+    return 0;
+}
+
+static void ICACHE_FLASH_ATTR _esp8266_ssid_framework_count_disconnect(uint8_t reason)
+{
+    //INCREMENT (SATURATING) THE COUNTER FOR WIFI DISCONNECT REASON
+
+    uint8_t slot = _esp8266_ssid_framework_reason_slot(reason);
+
+    if(_disconnect_reason_counts[slot] != 0xFFFF)
+    {
+        _disconnect_reason_counts[slot]++;
+    }
+#if ESP8266_SSID_FRAMEWORK_MODULE_STATS
+    if(_param_record.stats.disconnects[slot] != 0xFFFF)
+    {
+        _param_record.stats.disconnects[slot]++;
+        _esp8266_ssid_framework_stats_changed();
+    }
+#endif
+}
+
+static void ICACHE_FLASH_ATTR _esp8266_ssid_framework_load_candidate(uint8_t source, struct station_config* config)
+{
+    //FILL STATION CONFIG FROM SSID CANDIDATE SOURCE
+
+    switch(source)
+    {
+        case ESP8266_SSID_FRAMEWORK_SSID_SOURCE_SUPPLIED:
+            os_memcpy(config, _ssid_supplied_config, sizeof(struct station_config));
+            break;
+
+        case ESP8266_SSID_FRAMEWORK_SSID_SOURCE_INTERNAL:
+#if ESP8266_SSID_FRAMEWORK_MODULE_CREDENTIAL_CRYPT
+            _esp8266_ssid_framework_credential_load(config);
+#else
+            wifi_station_get_config_default(config);
+#endif
+            break;
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_INPUT_HARDCODED
+        case ESP8266_SSID_FRAMEWORK_SSID_SOURCE_HARDCODED:
+            os_memset(config, 0, sizeof(struct station_config));
+            os_memcpy(&config->ssid, _ssid_hardcoded_name_pwd.ssid_name, strlen(_ssid_hardcoded_name_pwd.ssid_name));
+            os_memcpy(&config->password, _ssid_hardcoded_name_pwd.ssid_pwd, strlen(_ssid_hardcoded_name_pwd.ssid_pwd));
+            break;
+#endif
+    }
+}
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_CONFIG_WEBCONFIG
+static uint8_t ICACHE_FLASH_ATTR _esp8266_ssid_framework_form_value(char* body, const char* name, char* value, uint8_t value_len)
+{
+    //COPY URL DECODED VALUE OF FORM FIELD name (x-www-form-urlencoded BODY)
+    //INTO value (TRUNCATED TO value_len - 1). EMPTY STRING IF NOT PRESENT
+    //RETURN 1 IF THE FIELD WAS PRESENT (COUNTED WHILE A PORTAL BENCHMARK RUNS)
+
+    uint8_t name_len = os_strlen(name);
+    uint8_t len = 0;
+    char* ptr = body;
+
+    value[0] = '\0';
+    while(ptr != NULL && *ptr != '\0')
+    {
+        if(os_strncmp(ptr, name, name_len) == 0 && ptr[name_len] == '=')
+        {
+            ptr += name_len + 1;
+            while(*ptr != '\0' && *ptr != '&' && *ptr != '\r' && *ptr != '\n' && len < value_len - 1)
+            {
+                char c = *ptr++;
+                if(c == '+')
+                {
+                    c = ' ';
+                }
+                else if(c == '%' && _esp8266_ssid_framework_hex_nibble(ptr[0]) != 0xFF && _esp8266_ssid_framework_hex_nibble(ptr[1]) != 0xFF)
+                {
+                    c = (char)((_esp8266_ssid_framework_hex_nibble(ptr[0]) << 4) | _esp8266_ssid_framework_hex_nibble(ptr[1]));
+                    ptr += 2;
+                }
+                value[len++] = c;
+            }
+            value[len] = '\0';
+#if ESP8266_SSID_FRAMEWORK_MODULE_PORTAL_BENCH
+            _bench_bytes_copied += len + 1;
+#endif
+            return 1;
+        }
+
+        //NEXT FIELD
+        ptr = os_strstr(ptr, "&");
+        if(ptr != NULL)
+        {
+            ptr++;
+        }
+    }
+    return 0;
+}
+
+static uint8_t ICACHE_FLASH_ATTR _esp8266_ssid_framework_parse_ip(char* str, ip_addr_t* addr)
+{
+    //PARSE DOTTED DECIMAL IP ADDRESS STRING
+    //RETURN 0 IF INVALID
+
+    uint32_t value = ipaddr_addr(str);
+
+    if(str[0] == '\0' || value == IPADDR_NONE)
+    {
+        return 0;
+    }
+    addr->addr = value;
+    return 1;
+}
+
+static uint8_t ICACHE_FLASH_ATTR _esp8266_ssid_framework_hex_nibble(char c)
+{
+    //RETURN VALUE OF HEX DIGIT (0xFF IF NOT A HEX DIGIT)
+
+    if(c >= '0' && c <= '9')
+        return c - '0';
+    if(c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if(c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return 0xFF;
+}
+
+static void ICACHE_FLASH_ATTR _esp8266_ssid_framework_page_append_escaped(const char* str)
+{
+    //APPEND STRING TO CONFIG PAGE HTML WITH & " < > ESCAPED
+    //(USER SUPPLIED TEXT IN ATTRIBUTES AND LABELS)
+
+    char buffer[64];
+    uint8_t len = 0;
+
+    while(*str != '\0')
+    {
+        if(len > sizeof(buffer) - 8)
+        {
+            buffer[len] = '\0';
+            _esp8266_ssid_framework_page_append(buffer);
+            len = 0;
+        }
+        switch(*str)
+        {
+            case '&':
+                os_memcpy(&buffer[len], "&amp;", 5);
+                len += 5;
+                break;
+            case '"':
+                os_memcpy(&buffer[len], "&quot;", 6);
+                len += 6;
+                break;
+            case '<':
+                os_memcpy(&buffer[len], "&lt;", 4);
+                len += 4;
+                break;
+            case '>':
+                os_memcpy(&buffer[len], "&gt;", 4);
+                len += 4;
+                break;
+            default:
+                buffer[len++] = *str;
+                break;
+        }
+        str++;
+    }
+    buffer[len] = '\0';
+    _esp8266_ssid_framework_page_append(buffer);
+}
+
+static void ICACHE_FLASH_ATTR _esp8266_ssid_framework_page_append_field(uint8_t index)
+{
+    //APPEND THE INPUT ELEMENT FOR CUSTOM FIELD index TO CONFIG PAGE HTML
+    //INPUT TYPE AND LIMITS FOLLOW THE FIELD TYPE SO THE BROWSER CHECKS FIRST
+
+    ESP8266_SSID_FRAMEWORK_CONFIG_USER_FIELD* field = _custom_user_field_group->custom_fields + index;
+    uint8_t* slot = _esp8266_ssid_framework_field_slot(index, field->custom_field_type);
+    char value[ESP8266_SSID_FRAMEWORK_CUSTOM_FIELD_VALUE_LEN];
+    char tag[100];
+    uint8_t i;
+
+    _esp8266_ssid_framework_field_format(index, value);
+
+    switch(field->custom_field_type)
+    {
+        case ESP8266_SSID_FRAMEWORK_FIELD_INT:
+            if(field->custom_field_min != field->custom_field_max)
+            {
+                os_sprintf(tag, "<input type=\"number\" min=\"%d\" max=\"%d\" name=\"", field->custom_field_min, field->custom_field_max);
+            }
+            else
+            {
+                os_strcpy(tag, "<input type=\"number\" name=\"");
+            }
+            break;
+
+        case ESP8266_SSID_FRAMEWORK_FIELD_BOOL:
+            os_sprintf(tag, "<input type=\"checkbox\" value=\"1\"%s name=\"", (slot != NULL && *slot) ? " checked" : "");
+            break;
+
+        case ESP8266_SSID_FRAMEWORK_FIELD_IPV4:
+            os_strcpy(tag, "<input type=\"text\" maxlength=\"15\" pattern=\"[0-9]{1,3}(\\.[0-9]{1,3}){3}\" name=\"");
+            break;
+
+        case ESP8266_SSID_FRAMEWORK_FIELD_ENUM:
+            os_strcpy(tag, "<select name=\"");
+            break;
+
+        default:
+            os_sprintf(tag, "<input type=\"text\" maxlength=\"%u\" name=\"", _esp8266_ssid_framework_field_size(field) - 1);
+            break;
+    }
+    _esp8266_ssid_framework_page_append(tag);
+    _esp8266_ssid_framework_page_append_escaped(field->custom_field_name);
+
+    if(field->custom_field_type == ESP8266_SSID_FRAMEWORK_FIELD_ENUM)
+    {
+        //EMPTY FIRST OPTION = NO VALUE
+        _esp8266_ssid_framework_page_append("\"><option value=\"\"></option>");
+        for(i = 0; i < field->custom_field_options_count; i++)
+        {
+            os_sprintf(tag, "<option value=\"%u\"%s>", i, (slot != NULL && *slot == i) ? " selected" : "");
+            _esp8266_ssid_framework_page_append(tag);
+            _esp8266_ssid_framework_page_append_escaped(field->custom_field_options[i]);
+            _esp8266_ssid_framework_page_append("</option>");
+        }
+        _esp8266_ssid_framework_page_append("</select>");
+    }
+    else if(field->custom_field_type == ESP8266_SSID_FRAMEWORK_FIELD_BOOL)
+    {
+        _esp8266_ssid_framework_page_append("\">");
+    }
+    else
+    {
+        _esp8266_ssid_framework_page_append("\" value=\"");
+        _esp8266_ssid_framework_page_append_escaped(value);
+        _esp8266_ssid_framework_page_append("\">");
+    }
+}
+
+static uint8_t ICACHE_FLASH_ATTR _esp8266_ssid_framework_parse_int(char* str, int32_t* value)
+{
+    //PARSE DECIMAL INTEGER STRING (OPTIONAL SIGN)
+    //RETURN 0 IF INVALID OR OUTSIDE int32_t
+
+    uint8_t negative = 0;
+    uint32_t result = 0;
+
+    if(*str == '-' || *str == '+')
+    {
+        negative = (*str == '-');
+        str++;
+    }
+    if(*str == '\0')
+    {
+        return 0;
+    }
+    while(*str != '\0')
+    {
+        if(*str < '0' || *str > '9' || result > 214748364UL)
+        {
+            return 0;
+        }
+        result = (result * 10) + (*str - '0');
+        if(result > (negative ? 2147483648UL : 2147483647UL))
+        {
+            return 0;
+        }
+        str++;
+    }
+    *value = negative ? -(int32_t)(result - 1) - 1 : (int32_t)result;
+    return 1;
+}
+
+static uint8_t ICACHE_FLASH_ATTR _esp8266_ssid_framework_field_encode(ESP8266_SSID_FRAMEWORK_CONFIG_USER_FIELD* field, char* text, uint8_t* slot)
+{
+    //VALIDATE A SUBMITTED CUSTOM FIELD VALUE AND WRITE IT PACKED INTO slot
+    //RETURN 0 IF THE VALUE DOES NOT FIT THE FIELD TYPE
+    //THE BYTES WRITTEN ARE COUNTED WHILE A PORTAL BENCHMARK RUNS
+
+    int32_t number;
+    ip_addr_t ip;
+
+    switch(field->custom_field_type)
+    {
+        case ESP8266_SSID_FRAMEWORK_FIELD_INT:
+            if(!_esp8266_ssid_framework_parse_int(text, &number) ||
+                (field->custom_field_min != field->custom_field_max &&
+                (number < field->custom_field_min || number > field->custom_field_max)))
+            {
+                return 0;
+            }
+            os_memcpy(slot, &number, sizeof(int32_t));
+#if ESP8266_SSID_FRAMEWORK_MODULE_PORTAL_BENCH
+            _bench_bytes_copied += sizeof(int32_t);
+#endif
+            return 1;
+
+        case ESP8266_SSID_FRAMEWORK_FIELD_BOOL:
+            *slot = (text[0] == '1' || os_strcmp(text, "on") == 0 || os_strcmp(text, "true") == 0);
+#if ESP8266_SSID_FRAMEWORK_MODULE_PORTAL_BENCH
+            _bench_bytes_copied += 1;
+#endif
+            return 1;
+
+        case ESP8266_SSID_FRAMEWORK_FIELD_IPV4:
+            if(!_esp8266_ssid_framework_parse_ip(text, &ip))
+            {
+                return 0;
+            }
+            os_memcpy(slot, &ip, sizeof(ip_addr_t));
+#if ESP8266_SSID_FRAMEWORK_MODULE_PORTAL_BENCH
+            _bench_bytes_copied += sizeof(ip_addr_t);
+#endif
+            return 1;
+
+        case ESP8266_SSID_FRAMEWORK_FIELD_ENUM:
+            if(!_esp8266_ssid_framework_parse_int(text, &number) || number < 0 || number >= field->custom_field_options_count)
+            {
+                return 0;
+            }
+            *slot = (uint8_t)number;
+#if ESP8266_SSID_FRAMEWORK_MODULE_PORTAL_BENCH
+            _bench_bytes_copied += 1;
+#endif
+            return 1;
+
+        default:
+            if(os_strlen(text) > _esp8266_ssid_framework_field_size(field) - 1)
+            {
+                return 0;
+            }
+            os_strcpy((char*)slot, text);
+#if ESP8266_SSID_FRAMEWORK_MODULE_PORTAL_BENCH
+            _bench_bytes_copied += os_strlen(text) + 1;
+#endif
+            return 1;
+    }
+}
+
+static uint8_t ICACHE_FLASH_ATTR _esp8266_ssid_framework_header_value(char* data, const char* name, uint8_t hex, uint32_t* value)
+{
+    //PARSE NUMERIC HTTP HEADER "name: value" (DECIMAL OR HEX)
+    //RETURN 0 IF THE HEADER IS NOT PRESENT
+
+    char* ptr = (char*)os_strstr(data, name);
+    uint8_t digits = 0;
+    uint8_t nibble;
+
+    if(ptr == NULL)
+    {
+        return 0;
+    }
+    ptr += os_strlen(name);
+    if(*ptr++ != ':')
+    {
+        return 0;
+    }
+    while(*ptr == ' ')
+    {
+        ptr++;
+    }
+
+    *value = 0;
+    while(1)
+    {
+        nibble = _esp8266_ssid_framework_hex_nibble(*ptr++);
+        if(nibble == 0xFF || (!hex && nibble > 9))
+        {
+            break;
+        }
+        *value = hex ? ((*value << 4) | nibble) : ((*value * 10) + nibble);
+        digits++;
+    }
+    return (digits != 0);
+}
+
+static void* ICACHE_FLASH_ATTR _esp8266_ssid_framework_portal_alloc(uint16_t len)
+{
+    //BUMP ALLOCATE A ZEROED PORTAL BUFFER FROM THE SESSION ARENA
+    //BUFFERS ARE FREED IN REVERSE ORDER OF ALLOCATION. HEAP IF THE ARENA IS FULL
+    //COUNTED WHILE A PORTAL BENCHMARK RUNS
+
+    void* ptr;
+
+    len = (len + 3) & ~3;
+    if(_session_arena != NULL && len <= _session_arena_stats.size - _session_arena_stats.in_use)
+    {
+        ptr = &_session_arena[_session_arena_stats.in_use];
+        os_memset(ptr, 0, len);
+        _session_arena_stats.in_use += len;
+        if(_session_arena_stats.in_use > _session_arena_stats.high_water)
+        {
+            _session_arena_stats.high_water = _session_arena_stats.in_use;
+        }
+    }
+    else
+    {
+        ptr = os_zalloc(len);
+        _session_arena_stats.fallbacks++;
+    }
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_PORTAL_BENCH
+    if(_bench_active)
+    {
+        _bench_allocations++;
+        _esp8266_ssid_framework_bench_sample_memory();
+    }
+#endif
+    return ptr;
+}
+
+static void ICACHE_FLASH_ATTR _esp8266_ssid_framework_portal_free(void* ptr)
+{
+    //FREE A PORTAL BUFFER. AN ARENA BUFFER GIVES BACK ITSELF AND EVERYTHING
+    //ALLOCATED AFTER IT
+
+    if(_session_arena != NULL && (uint8_t*)ptr >= _session_arena &&
+        (uint8_t*)ptr < _session_arena + ESP8266_SSID_FRAMEWORK_ARENA_LEN)
+    {
+        _session_arena_stats.in_use = (uint8_t*)ptr - _session_arena;
+        return;
+    }
+    os_free(ptr);
+}
+#endif
+
+static void ICACHE_FLASH_ATTR _esp8266_ssid_framework_mdns_build_hostname(void)
+{
+    //HOSTNAME = <PROJECT NAME>-<CHIP ID IN HEX>
+    //LOWER CASE, ANYTHING OTHER THAN a-z / 0-9 BECOMES '-'
+
+    char* name = (_project_name != NULL) ? _project_name : "esp8266";
+    uint8_t len = 0;
+
+    //KEEP ROOM FOR '-' + 8 HEX DIGITS + '\0'
+    while(*name != '\0' && len < ESP8266_SSID_FRAMEWORK_MDNS_HOSTNAME_LEN - 10)
+    {
+        char c = *name++;
+        if(c >= 'A' && c <= 'Z')
+        {
+            c += 'a' - 'A';
+        }
+        else if(!((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9')))
+        {
+            c = '-';
+        }
+        _mdns_hostname[len++] = c;
+    }
+    os_sprintf(&_mdns_hostname[len], "-%x", system_get_chip_id());
+}
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_STATION_MDNS
+static void ICACHE_FLASH_ATTR _esp8266_ssid_framework_mdns_txt_set(uint8_t index, const char* key, const char* value)
+{
+    //BUILD "key=value" MDNS TXT RECORD (TRUNCATED TO MDNS_TXT_LEN)
+
+    char* txt = _mdns_txt[index];
+    uint8_t len = 0;
+
+    while(*key != '\0' && len < ESP8266_SSID_FRAMEWORK_MDNS_TXT_LEN - 2)
+    {
+        txt[len++] = *key++;
+    }
+    txt[len++] = '=';
+    while(*value != '\0' && len < ESP8266_SSID_FRAMEWORK_MDNS_TXT_LEN - 1)
+    {
+        txt[len++] = *value++;
+    }
+    txt[len] = '\0';
+}
+#endif
+
+static uint8_t ICACHE_FLASH_ATTR _esp8266_ssid_framework_ip_config_store(uint8_t mode, struct ip_info* static_ip, ip_addr_t* static_dns)
+{
+    //UPDATE THE IP SETTINGS IN THE PARAMETER RECORD
+    //RETURN 1 IF SOMETHING CHANGED (CALLER SAVES THE RECORD)
+
+    if(_param_record.ip_mode == mode &&
+        (mode != ESP8266_SSID_FRAMEWORK_IP_MODE_STATIC ||
+        (os_memcmp(&_param_record.static_ip, static_ip, sizeof(struct ip_info)) == 0 &&
+        _param_record.static_dns.addr == static_dns->addr)))
+    {
+        return 0;
+    }
+
+    _param_record.ip_mode = mode;
+    if(mode == ESP8266_SSID_FRAMEWORK_IP_MODE_STATIC)
+    {
+        _param_record.static_ip = *static_ip;
+        _param_record.static_dns = *static_dns;
+    }
+    return 1;
+}
+
+static uint8_t ICACHE_FLASH_ATTR _esp8266_ssid_framework_image_region(uint8_t user2, uint32_t* addr, uint32_t* max_len)
+{
+    //FLASH REGION OF THE user1 / user2 FIRMWARE IMAGE FOR THE CURRENT FLASH MAP
+    //user1 IS ALWAYS AT 0x1000. user2 SITS HALF WAY INTO THE FLASH MAP. EACH
+    //IMAGE IS FOLLOWED BY THE 16KB USER PARAMETER AREA OF THE MAP
+    //RETURN 0 IF THE MAP HAS NO OTA PARTITIONS
+
+    switch(ESP8266_SYSINFO_GetSystemFlashMap())
+    {
+        case FLASH_SIZE_4M_MAP_256_256:
+            *addr = user2 ? 0x41000 : 0x1000;
+            *max_len = 0x3B000;
+            return 1;
+        case FLASH_SIZE_8M_MAP_512_512:
+        case FLASH_SIZE_16M_MAP_512_512:
+        case FLASH_SIZE_32M_MAP_512_512:
+            *addr = user2 ? 0x81000 : 0x1000;
+            *max_len = 0x7B000;
+            return 1;
+        case FLASH_SIZE_16M_MAP_1024_1024:
+        case FLASH_SIZE_32M_MAP_1024_1024:
+            *addr = user2 ? 0x101000 : 0x1000;
+            *max_len = 0xFB000;
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+static uint16_t ICACHE_FLASH_ATTR _esp8266_ssid_framework_param_sector(void)
+{
+    //START SECTOR OF THE PARAMETER RECORD (system_param_save_with_protect USES
+    //3 SECTORS FROM IT). DEFAULT = THE USER PARAMETER AREA RIGHT AFTER user1
+    //(0x3C / 0x7C / 0xFC). A SECTOR SET AT BUILD TIME MUST STAY CLEAR OF BOTH
+    //FIRMWARE IMAGES
+    //RETURN 0 IF THERE IS NO SAFE PLACE
+
+    uint32_t addr;
+    uint32_t max_len;
+    uint32_t start;
+    uint8_t user2;
+
+#ifdef ESP8266_SSID_FRAMEWORK_PARAM_START_SECTOR
+    start = ESP8266_SSID_FRAMEWORK_PARAM_START_SECTOR * SPI_FLASH_SEC_SIZE;
+    for(user2 = 0; user2 < 2; user2++)
+    {
+        if(_esp8266_ssid_framework_image_region(user2, &addr, &max_len) &&
+            start < addr + max_len && start + (3 * SPI_FLASH_SEC_SIZE) > addr)
+        {
+            os_printf("ESP8266 : SSID FRAMEWORK : Parameter sector 0x%X overlaps user%u (0x%X - 0x%X)!\n",
+                        ESP8266_SSID_FRAMEWORK_PARAM_START_SECTOR, user2 + 1, addr, addr + max_len);
+            return 0;
+        }
+    }
+    return ESP8266_SSID_FRAMEWORK_PARAM_START_SECTOR;
+#else
+    user2 = 0;
+    if(!_esp8266_ssid_framework_image_region(user2, &addr, &max_len))
+    {
+        //NO OTA MAP, NO RESERVED USER PARAMETER AREA. SET PARAM_START_SECTOR
+        return 0;
+    }
+    start = addr + max_len;
+    return start / SPI_FLASH_SEC_SIZE;
+#endif
+}
+
+static struct netif* ICACHE_FLASH_ATTR _esp8266_ssid_framework_netif_by_ip(ip_addr_t* ip)
+{
+    //LWIP INTERFACE THAT HOLDS ADDRESS ip (NULL IF NONE)
+
+    struct netif* netif;
+
+    for(netif = netif_list; netif != NULL; netif = netif->next)
+    {
+        if(netif->ip_addr.addr == ip->addr)
+        {
+            return netif;
+        }
+    }
+    return NULL;
+}
+
+static uint8_t ICACHE_FLASH_ATTR _esp8266_ssid_framework_field_size(ESP8266_SSID_FRAMEWORK_CONFIG_USER_FIELD* field)
+{
+    //BYTES TAKEN BY A CUSTOM FIELD IN THE PACKED VALUE STORE
+    //STRING MAX LENGTH 0 (OR TOO LONG) = LONGEST THAT FITS
+
+    switch(field->custom_field_type)
+    {
+        case ESP8266_SSID_FRAMEWORK_FIELD_INT:
+        case ESP8266_SSID_FRAMEWORK_FIELD_IPV4:
+            return 4;
+
+        case ESP8266_SSID_FRAMEWORK_FIELD_BOOL:
+        case ESP8266_SSID_FRAMEWORK_FIELD_ENUM:
+            return 1;
+
+        default:
+            if(field->custom_field_max_len == 0 || field->custom_field_max_len >= ESP8266_SSID_FRAMEWORK_CUSTOM_FIELD_VALUE_LEN)
+            {
+                return ESP8266_SSID_FRAMEWORK_CUSTOM_FIELD_VALUE_LEN;
+            }
+            return field->custom_field_max_len + 1;
+    }
+}
+
+static uint8_t* ICACHE_FLASH_ATTR _esp8266_ssid_framework_field_slot(uint8_t index, uint8_t type)
+{
+    //POINTER TO THE STORED (PACKED) VALUE OF CUSTOM FIELD index
+    //NULL IF NO SUCH FIELD, OTHER TYPE, NO VALUE OR STORED WITH ANOTHER FIELD LAYOUT
+
+    _esp8266_ssid_framework_param_load();
+
+    if(_custom_user_field_group == NULL ||
+        index >= _custom_user_field_group->custom_fields_count ||
+        (_custom_user_field_group->custom_fields + index)->custom_field_type != type ||
+        _param_record.custom_signature != _custom_field_signature ||
+        !(_param_record.custom_present & (1 << index)))
+    {
+        return NULL;
+    }
+    return &_param_record.custom_values[_custom_field_offset[index]];
+}
+
+static void ICACHE_FLASH_ATTR _esp8266_ssid_framework_field_format(uint8_t index, char* text)
+{
+    //WRITE THE STORED VALUE OF CUSTOM FIELD index AS TEXT (CUSTOM_FIELD_VALUE_LEN BUFFER)
+    //EMPTY STRING IF THE FIELD HAS NO VALUE. ENUM = OPTION STRING
+
+    ESP8266_SSID_FRAMEWORK_CONFIG_USER_FIELD* field = _custom_user_field_group->custom_fields + index;
+    uint8_t* slot = _esp8266_ssid_framework_field_slot(index, field->custom_field_type);
+    int32_t number;
+    ip_addr_t ip;
+
+    text[0] = '\0';
+    if(slot == NULL)
+    {
+        return;
+    }
+
+    switch(field->custom_field_type)
+    {
+        case ESP8266_SSID_FRAMEWORK_FIELD_INT:
+            os_memcpy(&number, slot, sizeof(int32_t));
+            os_sprintf(text, "%d", number);
+            break;
+
+        case ESP8266_SSID_FRAMEWORK_FIELD_BOOL:
+            os_strcpy(text, *slot ? "1" : "0");
+            break;
+
+        case ESP8266_SSID_FRAMEWORK_FIELD_IPV4:
+            os_memcpy(&ip, slot, sizeof(ip_addr_t));
+            os_sprintf(text, IPSTR, IP2STR(&ip));
+            break;
+
+        case ESP8266_SSID_FRAMEWORK_FIELD_ENUM:
+            if(*slot < field->custom_field_options_count)
+            {
+                os_strncpy(text, field->custom_field_options[*slot], ESP8266_SSID_FRAMEWORK_CUSTOM_FIELD_VALUE_LEN - 1);
+                text[ESP8266_SSID_FRAMEWORK_CUSTOM_FIELD_VALUE_LEN - 1] = '\0';
+            }
+            break;
+
+        default:
+            os_strcpy(text, (char*)slot);
+            break;
+    }
+}
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_OTA
+static uint32_t ICACHE_FLASH_ATTR _esp8266_ssid_framework_crc32_update(uint32_t crc, uint8_t* data, uint16_t len)
+{
+    //UPDATE RUNNING CRC32 (IEEE, REFLECTED). START WITH 0xFFFFFFFF, XOR THE RESULT
+    //WITH 0xFFFFFFFF AT THE END. BITWISE TO KEEP THE TABLE OUT OF RAM
+
+    uint8_t i;
+
+    while(len--)
+    {
+        crc ^= *data++;
+        for(i = 0; i < 8; i++)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320 & (-(crc & 1)));
+        }
+    }
+    return crc;
+}
+
+static uint8_t ICACHE_FLASH_ATTR _esp8266_ssid_framework_ota_key_matches(char* data)
+{
+    //CHECK THE "X-Firmware-Key: <key>" REQUEST HEADER AGAINST THE OTA KEY
+    //COMPARES THE WHOLE KEY LENGTH EVERY TIME, SO TIMING GIVES NOTHING AWAY
+    //RETURN 0 IF NO KEY IS SET, THE HEADER IS MISSING OR IT DOES NOT MATCH
+
+    char* ptr = (char*)os_strstr(data, "X-Firmware-Key:");
+    uint8_t diff = 0;
+    uint8_t i;
+
+    if(_ota_key[0] == '\0' || ptr == NULL)
+    {
+        return 0;
+    }
+    ptr += 15;
+    while(*ptr == ' ')
+    {
+        ptr++;
+    }
+
+    for(i = 0; i <= ESP8266_SSID_FRAMEWORK_OTA_KEY_LEN; i++)
+    {
+        //THE HEADER VALUE ENDS AT CR. BOTH SIDES READ AS 0 PAST THEIR END
+        char c = (*ptr == '\r' || *ptr == '\n') ? '\0' : *ptr;
+        diff |= c ^ _ota_key[i];
+        if(c != '\0')
+        {
+            ptr++;
+        }
+    }
+    return (diff == 0);
+}
+#endif
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_STATS
+static uint32_t ICACHE_FLASH_ATTR _esp8266_ssid_framework_stats_checksum(ESP8266_SSID_FRAMEWORK_STATS* stats)
+{
+    //ROTATE-XOR CHECKSUM OVER THE STATS WORDS (RTC COPY VALIDITY)
+
+    uint32_t* word = (uint32_t*)stats;
+    uint32_t sum = ESP8266_SSID_FRAMEWORK_STATS_RTC_MAGIC;
+    uint8_t i;
+
+    for(i = 0; i < sizeof(ESP8266_SSID_FRAMEWORK_STATS) / 4; i++)
+    {
+        sum = ((sum << 5) | (sum >> 27)) ^ word[i];
+    }
+    return sum;
+}
+#endif
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_CREDENTIAL_CRYPT
+static void ICACHE_FLASH_ATTR _esp8266_ssid_framework_chacha20_quarter_round(uint32_t* x, uint8_t a, uint8_t b, uint8_t c, uint8_t d)
+{
+    //CHACHA20 QUARTER ROUND ON STATE WORDS a, b, c, d
+
+    x[a] += x[b]; x[d] ^= x[a]; x[d] = (x[d] << 16) | (x[d] >> 16);
+    x[c] += x[d]; x[b] ^= x[c]; x[b] = (x[b] << 12) | (x[b] >> 20);
+    x[a] += x[b]; x[d] ^= x[a]; x[d] = (x[d] << 8) | (x[d] >> 24);
+    x[c] += x[d]; x[b] ^= x[c]; x[b] = (x[b] << 7) | (x[b] >> 25);
+}
+
+static void ICACHE_FLASH_ATTR _esp8266_ssid_framework_chacha20_xor(const uint32_t* key, uint32_t nonce0, uint32_t nonce1, uint8_t* data, uint16_t len)
+{
+    //XOR data WITH THE CHACHA20 KEYSTREAM (RFC 7539, BLOCK COUNTER FROM 1,
+    //NONCE = nonce0, nonce1, 0). ENCRYPT AND DECRYPT ARE THE SAME
+
+    uint32_t state[16];
+    uint32_t block[16];
+    uint32_t counter = 1;
+    uint16_t pos;
+    uint8_t i;
+
+    for(pos = 0; pos < len; pos += 64)
+    {
+        state[0] = 0x61707865;
+        state[1] = 0x3320646E;
+        state[2] = 0x79622D32;
+        state[3] = 0x6B206574;
+        os_memcpy(&state[4], key, 32);
+        state[12] = counter++;
+        state[13] = nonce0;
+        state[14] = nonce1;
+        state[15] = 0;
+
+        os_memcpy(block, state, sizeof(block));
+        for(i = 0; i < 10; i++)
+        {
+            _esp8266_ssid_framework_chacha20_quarter_round(block, 0, 4, 8, 12);
+            _esp8266_ssid_framework_chacha20_quarter_round(block, 1, 5, 9, 13);
+            _esp8266_ssid_framework_chacha20_quarter_round(block, 2, 6, 10, 14);
+            _esp8266_ssid_framework_chacha20_quarter_round(block, 3, 7, 11, 15);
+            _esp8266_ssid_framework_chacha20_quarter_round(block, 0, 5, 10, 15);
+            _esp8266_ssid_framework_chacha20_quarter_round(block, 1, 6, 11, 12);
+            _esp8266_ssid_framework_chacha20_quarter_round(block, 2, 7, 8, 13);
+            _esp8266_ssid_framework_chacha20_quarter_round(block, 3, 4, 9, 14);
+        }
+
+        for(i = 0; i < 64 && pos + i < len; i++)
+        {
+            data[pos + i] ^= (uint8_t)((block[i / 4] + state[i / 4]) >> (8 * (i % 4)));
+        }
+    }
+    os_memset(block, 0, sizeof(block));
+}
+
+static void ICACHE_FLASH_ATTR _esp8266_ssid_framework_siphash_round(uint64_t* v)
+{
+    //ONE SIPROUND ON STATE v[0..3]
+
+    v[0] += v[1]; v[1] = (v[1] << 13) | (v[1] >> 51); v[1] ^= v[0]; v[0] = (v[0] << 32) | (v[0] >> 32);
+    v[2] += v[3]; v[3] = (v[3] << 16) | (v[3] >> 48); v[3] ^= v[2];
+    v[0] += v[3]; v[3] = (v[3] << 21) | (v[3] >> 43); v[3] ^= v[0];
+    v[2] += v[1]; v[1] = (v[1] << 17) | (v[1] >> 47); v[1] ^= v[2]; v[2] = (v[2] << 32) | (v[2] >> 32);
+}
+
+static void ICACHE_FLASH_ATTR _esp8266_ssid_framework_siphash24(const uint32_t* key, const uint8_t* data, uint16_t len, uint8_t* out)
+{
+    //SIPHASH-2-4 OF data WITH 128 BIT key. 8 BYTE RESULT (LITTLE ENDIAN) IN out
+
+    uint64_t k0 = key[0] | ((uint64_t)key[1] << 32);
+    uint64_t k1 = key[2] | ((uint64_t)key[3] << 32);
+    uint64_t v[4];
+    uint64_t m;
+    uint16_t pos;
+    uint8_t i;
+
+    v[0] = k0 ^ 0x736F6D6570736575ULL;
+    v[1] = k1 ^ 0x646F72616E646F6DULL;
+    v[2] = k0 ^ 0x6C7967656E657261ULL;
+    v[3] = k1 ^ 0x7465646279746573ULL;
+
+    for(pos = 0; pos + 8 <= len; pos += 8)
+    {
+        m = 0;
+        for(i = 0; i < 8; i++)
+        {
+            m |= (uint64_t)data[pos + i] << (8 * i);
+        }
+        v[3] ^= m;
+        _esp8266_ssid_framework_siphash_round(v);
+        _esp8266_ssid_framework_siphash_round(v);
+        v[0] ^= m;
+    }
+
+    //LAST BLOCK : REMAINING BYTES + LENGTH IN THE TOP BYTE
+    m = (uint64_t)(len & 0xFF) << 56;
+    for(i = 0; pos + i < len; i++)
+    {
+        m |= (uint64_t)data[pos + i] << (8 * i);
+    }
+    v[3] ^= m;
+    _esp8266_ssid_framework_siphash_round(v);
+    _esp8266_ssid_framework_siphash_round(v);
+    v[0] ^= m;
+
+    v[2] ^= 0xFF;
+    for(i = 0; i < 4; i++)
+    {
+        _esp8266_ssid_framework_siphash_round(v);
+    }
+
+    m = v[0] ^ v[1] ^ v[2] ^ v[3];
+    for(i = 0; i < 8; i++)
+    {
+        out[i] = (uint8_t)(m >> (8 * i));
+    }
+}
+#endif
@@ -2,7 +2,8 @@
 * ESP8266 SSID CONNECT FRAMEWORK
 *
 * SOFT AP DETAILS
-* SSID = ESP8266 | PASSWORD = 123456789
+* SSID = <PROJECT NAME>-<LAST 3 MAC BYTES> | PASSWORD = 12345678
+* CHANNEL = LEAST CONGESTED ONE (SCANNED BEFORE STARTING)
 *
 * SET THE WIFI RECONNECT INTERVAL TO ATLEAST
 * 4000ms (4 s), SO AS TO GIVE ENOUGH TIME TO
@@ -20,19 +21,15 @@
 *                    TO HARDCODED SSID           OR IN TCP WEBSERVER
 *                                              - WIFI CONNECT SUCCESSFULL
 *                                              - ON RESTART CHECK FOR VALID SSID CACHE. IF FOUND
-*                                                CONNECT USING THAT ELSE USE HARDCODED ONE
+*                                                TRY THAT FIRST, THEN THE HARDCODED ONE
 *
 *  INTERNAL          NOT ABLE TO CONNECT       - START SSID FRAMEWORK EITHER IN SMARTCONFIG
 *                    TO INTERNALLY CACHED        OR IN TCP WEBSERVER
 *                    SSID                      - WIFI CONNECT SUCCESSFULL
 *                                              - AUTO CONNECT ON RESTART FROM INTERNAL SSID CACHE
 *
-*  FLASH             NOT ABLE TO CONNECT       - START SSID FRAMEWORK EITHER IN SMARTCONFIG
-*  EEPROM            TO SSID READ FROM           OR IN TCP WEBSERVER
-*                    FLASH/EEPROM AT GIVEN     - WIFI CONNECT SUCCESSFULL
-*                    ADDRESS                   - SAVE WIFI CREDENTIAL TO FLASH/EEPROM
-*                                              - ON RESTART, AGAIN READ FLASH/EEPROM ADDRESS
-*                                                AND CONNECT TO READ SSID
+*  FLASH             NOT IMPLEMENTED. THE MODE VALUES ARE RESERVED AND SELECTING
+*  EEPROM            THEM IS REPORTED AND IGNORED
 *
 *
 *
@@ -58,36 +55,269 @@
 #include "gpio.h"
 #include "os_type.h"
 #include "user_interface.h"
+#include "ping.h"
+#include "espconn.h"
+#include "lwip/netif.h"
+#include "netif/etharp.h"
 #include "string.h"
 #include "ESP8266_GPIO.h"
 #include "ESP8266_SYSINFO.h"
 
-#define ESP8266_SSID_HARDCODED
-#define ESP8266_SSID_WEBCONFIG
+//COMPILE TIME MODULE SELECTION
+//EVERY INPUT MODE, CONFIG MODE AND OPTIONAL FEATURE IS A MODULE. SET A MODULE
+//TO 0 (E.G. -DESP8266_SSID_FRAMEWORK_MODULE_OTA=0) AND ITS CODE, DATA AND
+//DRIVER INCLUDES ARE LEFT OUT. SELECTING A MODE THAT IS NOT COMPILED IN AT
+//RUN TIME IS REPORTED (DEBUG) AND IGNORED.
+//size_report.sh PRINTS THE IRAM/DRAM/FLASH COST OF EACH MODULE
+#ifndef ESP8266_SSID_FRAMEWORK_MODULE_INPUT_HARDCODED
+    #define ESP8266_SSID_FRAMEWORK_MODULE_INPUT_HARDCODED       1
+#endif
+#ifndef ESP8266_SSID_FRAMEWORK_MODULE_INPUT_INTERNAL
+    #define ESP8266_SSID_FRAMEWORK_MODULE_INPUT_INTERNAL        1
+#endif
+#ifndef ESP8266_SSID_FRAMEWORK_MODULE_INPUT_GPIO
+    #define ESP8266_SSID_FRAMEWORK_MODULE_INPUT_GPIO            1
+#endif
+#ifndef ESP8266_SSID_FRAMEWORK_MODULE_CONFIG_SMARTCONFIG
+    #define ESP8266_SSID_FRAMEWORK_MODULE_CONFIG_SMARTCONFIG    0
+#endif
+#ifndef ESP8266_SSID_FRAMEWORK_MODULE_CONFIG_WEBCONFIG
+    #define ESP8266_SSID_FRAMEWORK_MODULE_CONFIG_WEBCONFIG      1
+#endif
+#ifndef ESP8266_SSID_FRAMEWORK_MODULE_SYSTEM_PARAMS
+    #define ESP8266_SSID_FRAMEWORK_MODULE_SYSTEM_PARAMS         1
+#endif
+#ifndef ESP8266_SSID_FRAMEWORK_MODULE_ROAMING
+    #define ESP8266_SSID_FRAMEWORK_MODULE_ROAMING               1
+#endif
+#ifndef ESP8266_SSID_FRAMEWORK_MODULE_STATION_MDNS
+    #define ESP8266_SSID_FRAMEWORK_MODULE_STATION_MDNS          1
+#endif
+//OTA IS OFF BY DEFAULT : THE PORTAL IS OPEN TO ANYONE IN RADIO RANGE. ENABLE
+//IT ONLY WITH A PER DEVICE KEY (SEE ESP8266_SSID_FRAMEWORK_SetOtaKey)
+#ifndef ESP8266_SSID_FRAMEWORK_MODULE_OTA
+    #define ESP8266_SSID_FRAMEWORK_MODULE_OTA                   0
+#endif
+#ifndef ESP8266_SSID_FRAMEWORK_MODULE_STATS
+    #define ESP8266_SSID_FRAMEWORK_MODULE_STATS                 1
+#endif
+#ifndef ESP8266_SSID_FRAMEWORK_MODULE_PORTAL_BENCH
+    #define ESP8266_SSID_FRAMEWORK_MODULE_PORTAL_BENCH          0
+#endif
+#ifndef ESP8266_SSID_FRAMEWORK_MODULE_CREDENTIAL_CRYPT
+    #define ESP8266_SSID_FRAMEWORK_MODULE_CREDENTIAL_CRYPT      0
+#endif
+
+//SYSTEM PARAMS, OTA AND THE PORTAL BENCHMARK ARE PART OF THE CONFIG PORTAL
+#if !ESP8266_SSID_FRAMEWORK_MODULE_CONFIG_WEBCONFIG
+    #undef ESP8266_SSID_FRAMEWORK_MODULE_SYSTEM_PARAMS
+    #define ESP8266_SSID_FRAMEWORK_MODULE_SYSTEM_PARAMS         0
+    #undef ESP8266_SSID_FRAMEWORK_MODULE_OTA
+    #define ESP8266_SSID_FRAMEWORK_MODULE_OTA                   0
+    #undef ESP8266_SSID_FRAMEWORK_MODULE_PORTAL_BENCH
+    #define ESP8266_SSID_FRAMEWORK_MODULE_PORTAL_BENCH          0
+#endif
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_CONFIG_SMARTCONFIG
+    #include "ESP8266_SMARTCONFIG.h"
+#endif
+#if ESP8266_SSID_FRAMEWORK_MODULE_CONFIG_WEBCONFIG
+    #include "ESP8266_MDNS.h"
+    #include "ESP8266_TCP_SERVER.h"
+#endif
+#if ESP8266_SSID_FRAMEWORK_MODULE_OTA
+    #include "upgrade.h"
+#endif
 
 #define ESP8266_SSID_FRAMEWORK_WEBCONFIG_PATH_STRING		"/config"
 #define ESP8266_SSID_FRAMEWORK_SSID_NAME_LEN                32
 #define ESP8266_SSID_FRAMEWORK_SSID_PSWD_LEN                64
 #define ESP8266_SSID_FRAMEWORK_CUSTOM_FIELD_MAX_COUNT       5
+#define ESP8266_SSID_FRAMEWORK_CUSTOM_FIELD_VALUE_LEN       32
+//PACKED CUSTOM FIELD VALUES (EVERY FIELD SLOT IS AT MOST VALUE_LEN BYTES)
+#define ESP8266_SSID_FRAMEWORK_CUSTOM_FIELD_STORE_LEN       (ESP8266_SSID_FRAMEWORK_CUSTOM_FIELD_MAX_COUNT * ESP8266_SSID_FRAMEWORK_CUSTOM_FIELD_VALUE_LEN)
+//ROOM FOR THE FULL PAGE WITH MAX CUSTOM FIELDS, OTA AND CONNECTION STATS
+#define ESP8266_SSID_FRAMEWORK_CONFIG_PAGE_LEN              6144
+#define ESP8266_SSID_FRAMEWORK_STATUS_STRING_LEN            128
+//A FORM POST WHOSE BODY ARRIVES AFTER THE HEADER IS REASSEMBLED UP TO THIS SIZE
+#define ESP8266_SSID_FRAMEWORK_POST_MAX_LEN                 1200
+//SESSION ARENA : ONE BLOCK RESERVED WHEN THE PORTAL STARTS AND RELEASED IN ONE
+//SHOT AT TEARDOWN. HOLDS THE CONFIG PAGE AND EVERY TRANSIENT PORTAL BUFFER
+//(POST REASSEMBLY, PAGE GENERATION SCRATCH), SO PROVISIONING LEAVES NO HEAP
+//HOLES BEHIND. SCRATCH COVERS A FULL POST PLUS THE LARGEST PAGE SCRATCH BUFFER
+#define ESP8266_SSID_FRAMEWORK_ARENA_SCRATCH_LEN            1536
+#define ESP8266_SSID_FRAMEWORK_ARENA_LEN                    (ESP8266_SSID_FRAMEWORK_CONFIG_PAGE_LEN + ESP8266_SSID_FRAMEWORK_ARENA_SCRATCH_LEN)
+//WITHOUT AN ARENA EVERY PORTAL BUFFER COMES FROM THE HEAP. IF NOT EVEN THE
+//CONFIG PAGE FITS, STARTING THE PORTAL IS RETRIED AFTER THIS LONG
+#define ESP8266_SSID_FRAMEWORK_PORTAL_RETRY_MS              2000
 
-#if defined(ESP8266_SSID_FLASH)
-    #include "ESP8266_FLASH.h"
-#elif defined(ESP8266_SSID_EEPROM)
-    #include "ESP8266_EEPROM_AT24.h"
-#elif defined(ESP8266_SSID_SMARTCONFIG)
-    #include "ESP8266_SMARTCONFIG.h"
-#elif defined(ESP8266_SSID_WEBCONFIG)
-    #include "ESP8266_MDNS.h"
-    #include "ESP8266_TCP_SERVER.h"
+//PORTAL BENCHMARK RELATED (SEE ESP8266_SSID_FRAMEWORK_RunPortalBenchmark)
+//THE FRAGMENTED POST IS REPLAYED AS THE HEADER, THEN THE BODY IN FRAGMENT LEN PIECES
+#define ESP8266_SSID_FRAMEWORK_BENCH_MAX_ITERATIONS         32
+#define ESP8266_SSID_FRAMEWORK_BENCH_FRAGMENT_LEN           64
+
+//CREDENTIAL CHECK (WEBCONFIG) RELATED
+//SUBMITTED CREDENTIALS ARE TRIED IN STATION+SOFTAP MODE BEFORE THE PORTAL
+//IS TORN DOWN. AFTER A SUCCESSFUL CHECK THE PORTAL STAYS UP UNTIL A CLIENT
+//HAS LOADED THE RESULT PAGE (THEN FOR TEARDOWN DELAY) OR FOR RESULT GRACE
+//IF NOBODY COMES BACK FOR IT
+#define ESP8266_SSID_FRAMEWORK_CREDENTIAL_CHECK_TIMEOUT_MS  15000
+#define ESP8266_SSID_FRAMEWORK_PORTAL_TEARDOWN_DELAY_MS     5000
+#define ESP8266_SSID_FRAMEWORK_PORTAL_RESULT_GRACE_MS       60000
+#define ESP8266_SSID_FRAMEWORK_PAGE_REFRESH_S               3
+
+//SOFTAP RELATED
+//CHANNEL IS PICKED FROM 1 - CHANNEL_MAX BY A SCAN BEFORE THE SOFTAP COMES UP
+#define ESP8266_SSID_FRAMEWORK_SOFTAP_CHANNEL_MAX           11
+#define ESP8266_SSID_FRAMEWORK_SOFTAP_DEFAULT_CHANNEL       1
+//APS UP TO THIS MANY CHANNELS AWAY COUNT AGAINST A CHANNEL
+#define ESP8266_SSID_FRAMEWORK_SOFTAP_CHANNEL_OVERLAP       4
+
+//CONNECTION RETRY RELATED
+//DISCONNECT REASONS ARE SPLIT INTO TRANSIENT (RETRIED) AND TERMINAL (WRONG
+//PASSWORD, AP NOT FOUND). A TERMINAL REASON SKIPS THE REMAINING RETRIES AND
+//MOVES ON TO THE NEXT STORED CREDENTIAL OR TO SSID CONFIGURATION.
+//SET NO_AP_FOUND_IS_TERMINAL TO 0 IF DEVICES USUALLY BOOT BEFORE THE AP DOES
+#define ESP8266_SSID_FRAMEWORK_SSID_CANDIDATE_MAX_COUNT     2
+#define ESP8266_SSID_FRAMEWORK_REASON_SLOT_COUNT            30
+#ifndef ESP8266_SSID_FRAMEWORK_NO_AP_FOUND_IS_TERMINAL
+    #define ESP8266_SSID_FRAMEWORK_NO_AP_FOUND_IS_TERMINAL  1
+#endif
+
+//LINK SUPERVISION RELATED
+//AFTER GOT IP THE GATEWAY IS PINGED EVERY PROBE INTERVAL. A DROPPED LINK (OR
+//PROBE FAIL LIMIT CONSECUTIVE PROBE FAILURES) IS RECOVERED WITH EXPONENTIAL
+//BACKOFF RECONNECTS. SSID CONFIGURATION STARTS ONLY ONCE THE OUTAGE BUDGET
+//IS USED UP (OUTAGE BUDGET 0 = NEVER)
+#define ESP8266_SSID_FRAMEWORK_PROBE_INTERVAL_MS            30000
+#define ESP8266_SSID_FRAMEWORK_PROBE_FAIL_LIMIT             3
+#define ESP8266_SSID_FRAMEWORK_OUTAGE_BUDGET_MS             600000
+#define ESP8266_SSID_FRAMEWORK_RECONNECT_BACKOFF_MIN_MS     1000
+#define ESP8266_SSID_FRAMEWORK_RECONNECT_BACKOFF_MAX_MS     60000
+
+//LINK DOWN CB REASON WHEN THE GATEWAY PROBE FAILED (SDK REASONS ARE NON ZERO)
+#define ESP8266_SSID_FRAMEWORK_LINK_DOWN_PROBE_FAILED       0
+
+//ROAMING RELATED (OPTIONAL, SEE ESP8266_SSID_FRAMEWORK_SetRoaming)
+//RSSI IS SAMPLED INTO A MOVING AVERAGE (WEIGHT 1/2^RSSI_AVG_SHIFT). WHEN IT
+//DROPS BELOW THE THRESHOLD AFTER MIN DWELL, A SINGLE CHANNEL SCAN (CHANNEL OF
+//THE BEST CACHED BSSID) IS RUN. EVERY FULL_SCAN_EVERY-TH SCAN (OR WITH AN
+//EMPTY CACHE) ALL CHANNELS ARE SCANNED. A BSSID OF THE SAME SSID MUST BEAT
+//THE AVERAGE BY HYSTERESIS DB TO BE JOINED
+#define ESP8266_SSID_FRAMEWORK_ROAM_SAMPLE_INTERVAL_MS      2000
+#define ESP8266_SSID_FRAMEWORK_ROAM_RSSI_AVG_SHIFT          3
+#define ESP8266_SSID_FRAMEWORK_ROAM_RSSI_THRESHOLD          -75
+#define ESP8266_SSID_FRAMEWORK_ROAM_HYSTERESIS_DB           8
+#define ESP8266_SSID_FRAMEWORK_ROAM_MIN_DWELL_MS            60000
+#define ESP8266_SSID_FRAMEWORK_ROAM_FULL_SCAN_EVERY         4
+#define ESP8266_SSID_FRAMEWORK_ROAM_CACHE_COUNT             4
+
+//IP CONFIGURATION RELATED (SEE ESP8266_SSID_FRAMEWORK_SetIpMode)
+//STATIC = FIXED IP/GATEWAY/DNS, NO DHCP
+//LEASE REUSE = LAST DHCP LEASE ON THE SAME SSID IS REAPPLIED. THE ADDRESS IS
+//PROBED WITH PROBE COUNT ARP REQUESTS, ARP WAIT APART. IF ANY HOST ANSWERS,
+//DHCP IS USED INSTEAD
+#define ESP8266_SSID_FRAMEWORK_LEASE_PROBE_COUNT            3
+#define ESP8266_SSID_FRAMEWORK_LEASE_ARP_WAIT_MS            300
+
+//MDNS RELATED
+//AFTER GOT IP THE DEVICE ANSWERS AS <PROJECT NAME>-<CHIP ID>.local AND
+//ADVERTISES _<SERVICE>._tcp WITH THE CUSTOM FIELD VALUES AS TXT RECORDS.
+//THE ANNOUNCEMENT IS REPEATED ANNOUNCE COUNT TIMES, ANNOUNCE INTERVAL APART.
+//THE SOFTAP PORTAL USES THE SAME HOSTNAME
+#define ESP8266_SSID_FRAMEWORK_MDNS_SERVICE                 "esp8266"
+#define ESP8266_SSID_FRAMEWORK_MDNS_PORT                    80
+#define ESP8266_SSID_FRAMEWORK_MDNS_HOSTNAME_LEN            32
+#define ESP8266_SSID_FRAMEWORK_MDNS_TXT_LEN                 64
+#define ESP8266_SSID_FRAMEWORK_MDNS_ANNOUNCE_COUNT          3
+#define ESP8266_SSID_FRAMEWORK_MDNS_ANNOUNCE_INTERVAL_MS    1000
+
+//OTA RELATED
+//THE IMAGE (user1.bin / user2.bin FOR THE INACTIVE SLOT) IS POSTED AS RAW BODY
+//TO OTA PATH AND STREAMED INTO THE INACTIVE PARTITION WRITE_CHUNK BYTES AT A
+//TIME. EVERY CHUNK IS READ BACK AND ADDED TO A CRC32, WHICH MUST MATCH THE
+//X-Firmware-CRC32 HEADER (SENT BY THE CONFIG PAGE). AN UPLOAD WITHOUT THE
+//HEADER IS REFUSED
+//THE SOFTAP PASSWORD IS PUBLIC, SO AN UPLOAD ALSO NEEDS THE X-Firmware-Key
+//HEADER TO MATCH THE KEY SET WITH ESP8266_SSID_FRAMEWORK_SetOtaKey. NO KEY SET
+//= NO UPLOADS
+#define ESP8266_SSID_FRAMEWORK_OTA_KEY_LEN                  32
+#define ESP8266_SSID_FRAMEWORK_OTA_KEY_MIN_LEN              8
+#define ESP8266_SSID_FRAMEWORK_OTA_PATH_STRING              "/update"
+#define ESP8266_SSID_FRAMEWORK_OTA_WRITE_CHUNK              256
+#define ESP8266_SSID_FRAMEWORK_OTA_IDLE_TIMEOUT_MS          10000
+#define ESP8266_SSID_FRAMEWORK_OTA_REBOOT_DELAY_MS          3000
+
+//EVENT RELATED (SEE ESP8266_SSID_FRAMEWORK_Subscribe)
+//EVENTS ARE QUEUED AS FIXED SIZE RECORDS FROM THE SDK CALLBACKS AND DELIVERED
+//TO THE LISTENERS (AND THE LEGACY CB FUNCTIONS) FROM AN SDK TASK. A FULL QUEUE
+//DROPS THE NEW EVENT. PICK A TASK PRIORITY THE APPLICATION DOES NOT USE. IF
+//IT IS TAKEN THIS IS PRINTED AT INIT AND EVENTS ARE DELIVERED FROM A TIMER
+#define ESP8266_SSID_FRAMEWORK_EVENT_QUEUE_LEN              8
+#define ESP8266_SSID_FRAMEWORK_EVENT_LISTENER_MAX_COUNT     4
+#ifndef ESP8266_SSID_FRAMEWORK_EVENT_TASK_PRIO
+    #define ESP8266_SSID_FRAMEWORK_EVENT_TASK_PRIO          USER_TASK_PRIO_1
+#endif
+#define ESP8266_SSID_FRAMEWORK_EVENT_MASK(type)             (1UL << (type))
+#define ESP8266_SSID_FRAMEWORK_EVENT_MASK_ALL               0xFFFFFFFFUL
+//THE WIFI CONNECTED CB IS CALLED THIS LONG AFTER THE FIRST CONNECTION SO THE
+//SDK CAN FINISH SAVING THE CREDENTIALS BEFORE THE USER TOUCHES FLASH
+#define ESP8266_SSID_FRAMEWORK_CONNECTED_CB_DELAY_MS        1000
+
+//CONNECTION STATS RELATED (SEE ESP8266_SSID_FRAMEWORK_GetStats)
+//KEPT IN RTC MEMORY FROM RTC BLOCK ON (UPDATED ON EVERY CHANGE, SURVIVES RESETS
+//AND DEEP SLEEP) AND IN THE PARAMETER RECORD (SURVIVES POWER LOSS). FLASH IS
+//WRITTEN ONCE EARLY IN EACH BOOT (SHORTLY AFTER THE FIRST IP, OR AFTER THE
+//EARLY FLUSH DELAY IF THAT COMES FIRST), THEN AT MOST ONCE PER FLASH INTERVAL
+//OF UPTIME, AND ONLY IF SOMETHING CHANGED. A POWER LOSS LOSES AT MOST ONE
+//INTERVAL, AND DEVICES POWER CYCLED MORE OFTEN STILL GET THEIR BOOTS SAVED.
+//TIME TO IP BUCKET n COUNTS CONNECTS BELOW (BUCKET BASE << n) MS, THE LAST
+//BUCKET EVERYTHING LONGER
+#ifndef ESP8266_SSID_FRAMEWORK_STATS_RTC_BLOCK
+    #define ESP8266_SSID_FRAMEWORK_STATS_RTC_BLOCK          64
 #endif
+#define ESP8266_SSID_FRAMEWORK_STATS_RTC_MAGIC              0x53544154
+#define ESP8266_SSID_FRAMEWORK_STATS_FLASH_INTERVAL_MS      3600000
+#define ESP8266_SSID_FRAMEWORK_STATS_EARLY_FLUSH_MS         180000
+#define ESP8266_SSID_FRAMEWORK_STATS_TTI_BUCKET_COUNT       8
+#define ESP8266_SSID_FRAMEWORK_STATS_TTI_BUCKET_BASE_MS     250
+
+//CREDENTIAL ENCRYPTION RELATED (MODULE CREDENTIAL_CRYPT)
+//STATION CREDENTIALS ARE KEPT IN THE PARAMETER RECORD, ENCRYPTED WITH CHACHA20
+//AND AUTHENTICATED WITH SIPHASH-2-4. THE KEYS ARE DERIVED FROM THE CHIP ID AND
+//THE BUILD SECRET, SO A FLASH DUMP ALONE DOES NOT GIVE THE NETWORK KEY. THE
+//SDK'S PLAINTEXT COPY IS WIPED AND CONNECTS ONLY SET THE CURRENT CONFIG.
+//DEFINE THE SECRET PER PRODUCT : -DESP8266_SSID_FRAMEWORK_CREDENTIAL_SECRET=\"...\"
+#if ESP8266_SSID_FRAMEWORK_MODULE_CREDENTIAL_CRYPT && !defined(ESP8266_SSID_FRAMEWORK_CREDENTIAL_SECRET)
+    #error "ESP8266_SSID_FRAMEWORK_CREDENTIAL_SECRET must be defined for MODULE_CREDENTIAL_CRYPT"
+#endif
+#define ESP8266_SSID_FRAMEWORK_CREDENTIAL_LEN               (ESP8266_SSID_FRAMEWORK_SSID_NAME_LEN + ESP8266_SSID_FRAMEWORK_SSID_PSWD_LEN)
+#define ESP8266_SSID_FRAMEWORK_CREDENTIAL_MAC_LEN           8
+
+//PASSWORDS ARE ONLY PRINTED (DEBUG) IF PRINT_SECRETS IS SET
+#ifndef ESP8266_SSID_FRAMEWORK_PRINT_SECRETS
+    #define ESP8266_SSID_FRAMEWORK_PRINT_SECRETS            0
+#endif
+
+//FRAMEWORK PARAMETER RECORD RELATED
+//STORED WITH system_param_save_with_protect (USES 3 SECTORS FROM START SECTOR)
+//THE START SECTOR IS THE USER PARAMETER AREA THE FLASH MAP RESERVES AFTER
+//user1 (0x3C FOR 256+256, 0x7C FOR 512+512, 0xFC FOR 1024+1024). DEFINE
+//ESP8266_SSID_FRAMEWORK_PARAM_START_SECTOR TO PLACE IT YOURSELF (NEEDED ON
+//MAPS WITHOUT OTA PARTITIONS). A SECTOR THAT OVERLAPS EITHER FIRMWARE IMAGE
+//IS REPORTED AND NOTHING IS STORED
+#define ESP8266_SSID_FRAMEWORK_PARAM_MAGIC                  0x53534657
+//VERSION 2 ADDS THE CUSTOM FIELD VALUES, VERSION 3 THE CONNECTION STATS,
+//VERSION 4 THE ENCRYPTED CREDENTIALS. OLDER RECORDS ARE TAKEN OVER
+#define ESP8266_SSID_FRAMEWORK_PARAM_VERSION                4
 
 
 //CUSTOM VARIABLE STRUCTURES/////////////////////////////
 typedef enum
 {
     ESP8266_SSID_FRAMEWORK_SSID_INPUT_HARDCODED = 0,
-    ESP8266_SSID_FRAMEWORK_SSID_INPUT_FLASH,
-    ESP8266_SSID_FRAMEWORK_SSID_INPUT_EEPROM,
+    ESP8266_SSID_FRAMEWORK_SSID_INPUT_FLASH,        //RESERVED, NOT IMPLEMENTED
+    ESP8266_SSID_FRAMEWORK_SSID_INPUT_EEPROM,       //RESERVED, NOT IMPLEMENTED
     ESP8266_SSID_FRAMEWORK_SSID_INPUT_INTERNAL,
     ESP8266_SSID_FRAMEWORK_SSID_INPUT_GPIO
 }ESP8266_SSID_FRAMEWORK_SSID_INPUT_MODE;
@@ -104,28 +334,222 @@ typedef struct
     char* ssid_pwd;
 }ESP8266_SSID_FRAMEWORK_HARDCODED_SSID_DETAILS;
 
+typedef enum
+{
+    ESP8266_SSID_FRAMEWORK_CONFIG_SMARTCONFIG = 0,
+    ESP8266_SSID_FRAMEWORK_CONFIG_WEBCONFIG
+}ESP8266_SSID_FRAMEWORK_CONFIG_MODE;
+
+typedef struct
+{
+    uint8_t bssid[6];
+    uint8_t channel;
+    int8_t rssi;
+}ESP8266_SSID_FRAMEWORK_ROAM_CACHE_ENTRY;
+
+typedef enum
+{
+    ESP8266_SSID_FRAMEWORK_SSID_SOURCE_SUPPLIED = 0,
+    ESP8266_SSID_FRAMEWORK_SSID_SOURCE_INTERNAL,
+    ESP8266_SSID_FRAMEWORK_SSID_SOURCE_HARDCODED
+}ESP8266_SSID_FRAMEWORK_SSID_SOURCE;
+
+typedef enum
+{
+    ESP8266_SSID_FRAMEWORK_STATE_IDLE = 0,
+    ESP8266_SSID_FRAMEWORK_STATE_CONNECTING,
+    ESP8266_SSID_FRAMEWORK_STATE_PROVISIONING,
+    ESP8266_SSID_FRAMEWORK_STATE_CHECKING_CREDENTIALS,
+    ESP8266_SSID_FRAMEWORK_STATE_CONNECTED,
+    ESP8266_SSID_FRAMEWORK_STATE_RECOVERING
+}ESP8266_SSID_FRAMEWORK_STATE;
+
+typedef enum
+{
+    ESP8266_SSID_FRAMEWORK_IP_MODE_DHCP = 0,
+    ESP8266_SSID_FRAMEWORK_IP_MODE_STATIC,
+    ESP8266_SSID_FRAMEWORK_IP_MODE_LEASE_REUSE,
+    ESP8266_SSID_FRAMEWORK_IP_MODE_COUNT
+}ESP8266_SSID_FRAMEWORK_IP_MODE;
+
 typedef struct
 {
-    uint32_t ssid_name_addr;
-    uint32_t ssid_pwdaddr;
-}ESP8266_SSID_FRAMEWORK_FLASH_SSID_DETAILS;
+    uint32_t image_len;
+    uint32_t duration_ms;
+    uint32_t bytes_per_s;
+    uint32_t min_free_heap;
+}ESP8266_SSID_FRAMEWORK_OTA_STATS;
 
+//SESSION ARENA USE (CURRENT OR LAST PROVISIONING SESSION)
+//fallbacks = BUFFERS THAT DID NOT FIT AND CAME FROM THE HEAP INSTEAD
 typedef struct
 {
-    uint32_t ssid_name_addr;
-    uint32_t ssid_pwdaddr;
-}ESP8266_SSID_FRAMEWORK_EEPROM_SSID_DETAILS;
+    uint16_t size;
+    uint16_t in_use;
+    uint16_t high_water;
+    uint16_t fallbacks;
+}ESP8266_SSID_FRAMEWORK_ARENA_STATS;
+
+//PORTAL BENCHMARK RESULT FOR ONE REQUEST KIND
+//LATENCY PERCENTILES OVER ALL ITERATIONS. BYTES COPIED (INTO THE PAGE,
+//REASSEMBLY AND FORM FIELD BUFFERS AND THE PACKED CUSTOM FIELD VALUES),
+//ALLOCATIONS, PEAK HEAP AND PEAK ARENA (BYTES IN USE
+//ABOVE THE START OF THE REQUEST) ARE THE MAXIMUM OF A SINGLE REQUEST.
+//PORTAL BUFFERS COME FROM THE SESSION ARENA, SO PEAK HEAP ONLY GROWS WHEN
+//THE ARENA IS FULL (OR SOMETHING OUTSIDE IT ALLOCATES)
+typedef struct
+{
+    uint32_t p50_us;
+    uint32_t p90_us;
+    uint32_t p99_us;
+    uint32_t max_us;
+    uint32_t bytes_copied;
+    uint16_t allocations;
+    uint16_t peak_heap;
+    uint16_t peak_arena;
+}ESP8266_SSID_FRAMEWORK_BENCH_STATS;
+
+typedef struct
+{
+    uint8_t field_count;
+    uint8_t iterations;
+    uint16_t request_len;
+    ESP8266_SSID_FRAMEWORK_BENCH_STATS get;
+    ESP8266_SSID_FRAMEWORK_BENCH_STATS post;
+    ESP8266_SSID_FRAMEWORK_BENCH_STATS post_fragmented;
+}ESP8266_SSID_FRAMEWORK_BENCH_RESULT;
 
 typedef enum
 {
-    ESP8266_SSID_FRAMEWORK_CONFIG_SMARTCONFIG = 0,
-    ESP8266_SSID_FRAMEWORK_CONFIG_WEBCONFIG
-}ESP8266_SSID_FRAMEWORK_CONFIG_MODE;
+    ESP8266_SSID_FRAMEWORK_BENCH_GET = 0,
+    ESP8266_SSID_FRAMEWORK_BENCH_POST,
+    ESP8266_SSID_FRAMEWORK_BENCH_POST_FRAGMENTED
+}ESP8266_SSID_FRAMEWORK_BENCH_KIND;
+
+typedef enum
+{
+    ESP8266_SSID_FRAMEWORK_EVENT_CONNECTING = 0,
+    ESP8266_SSID_FRAMEWORK_EVENT_CONNECTED,
+    ESP8266_SSID_FRAMEWORK_EVENT_DISCONNECTED,
+    ESP8266_SSID_FRAMEWORK_EVENT_LINK_LOST,
+    ESP8266_SSID_FRAMEWORK_EVENT_PROVISIONING_STARTED,
+    ESP8266_SSID_FRAMEWORK_EVENT_CREDENTIALS_RECEIVED,
+    ESP8266_SSID_FRAMEWORK_EVENT_PORTAL_CLIENT_JOINED,
+    ESP8266_SSID_FRAMEWORK_EVENT_COUNT
+}ESP8266_SSID_FRAMEWORK_EVENT_TYPE;
+
+//EVENT RECORD
+//detail : CONNECTING = SSID SOURCE | DISCONNECTED, LINK_LOST = DISCONNECT REASON
+//         PROVISIONING_STARTED = CONFIG MODE | PORTAL_CLIENT_JOINED = CLIENT AID
+//ip     : CONNECTED = STATION IP
+//mac    : PORTAL_CLIENT_JOINED = CLIENT MAC
+typedef struct
+{
+    uint8_t type;
+    uint8_t detail;
+    uint8_t mac[6];
+    ip_addr_t ip;
+    uint32_t time_ms;
+}ESP8266_SSID_FRAMEWORK_EVENT;
+
+typedef struct
+{
+    uint32_t mask;
+    void (*listener)(ESP8266_SSID_FRAMEWORK_EVENT* event, void* arg);
+    void* arg;
+}ESP8266_SSID_FRAMEWORK_EVENT_LISTENER;
+
+typedef struct
+{
+    uint8_t depth;
+    uint8_t high_water;
+    uint16_t reserved;
+    uint32_t posted;
+    uint32_t dropped;
+}ESP8266_SSID_FRAMEWORK_EVENT_STATS;
+
+//CONNECTION STATS (KEEP SIZE A MULTIPLE OF 4)
+//disconnects  : SAME SLOTS AS THE DISCONNECT COUNTERS (0 = UNKNOWN, 1-24 =
+//               802.11 REASONS 1-24, 25-29 = ESP REASONS 200-204)
+//rssi_avg_x16 : AVERAGE RSSI * 16. RUNNING MEAN OVER THE FIRST 256 SAMPLES, THEN MOVING
+typedef struct
+{
+    uint32_t boot_count;
+    uint16_t time_to_ip[ESP8266_SSID_FRAMEWORK_STATS_TTI_BUCKET_COUNT];
+    uint16_t disconnects[ESP8266_SSID_FRAMEWORK_REASON_SLOT_COUNT];
+    int8_t rssi_min;
+    int8_t rssi_max;
+    int16_t rssi_avg_x16;
+    uint16_t rssi_samples;
+    uint16_t portal_entries;
+}ESP8266_SSID_FRAMEWORK_STATS;
+
+typedef struct
+{
+    uint32_t magic;
+    uint32_t checksum;
+    ESP8266_SSID_FRAMEWORK_STATS stats;
+}ESP8266_SSID_FRAMEWORK_STATS_RTC_RECORD;
+
+//ENCRYPTED STATION CREDENTIALS (KEEP SIZE A MULTIPLE OF 4)
+//data : SSID + PASSWORD, CHACHA20 WITH NONCE (counter, CHIP ID)
+//mac  : SIPHASH-2-4 OVER EVERYTHING BEFORE IT
+typedef struct
+{
+    uint32_t counter;
+    uint8_t present;
+    uint8_t reserved[3];
+    uint8_t data[ESP8266_SSID_FRAMEWORK_CREDENTIAL_LEN];
+    uint8_t mac[ESP8266_SSID_FRAMEWORK_CREDENTIAL_MAC_LEN];
+}ESP8266_SSID_FRAMEWORK_CREDENTIAL_RECORD;
 
+//FRAMEWORK PARAMETER RECORD (KEEP SIZE A MULTIPLE OF 4)
+typedef struct
+{
+    uint32_t magic;
+    uint16_t version;
+    uint8_t ip_mode;
+    uint8_t reserved;
+    struct ip_info static_ip;
+    ip_addr_t static_dns;
+    struct ip_info lease;
+    ip_addr_t lease_dns;
+    uint8_t lease_ssid[ESP8266_SSID_FRAMEWORK_SSID_NAME_LEN];
+    uint32_t custom_signature;
+    uint8_t custom_present;
+    uint8_t custom_reserved[3];
+    uint8_t custom_values[ESP8266_SSID_FRAMEWORK_CUSTOM_FIELD_STORE_LEN];
+    ESP8266_SSID_FRAMEWORK_STATS stats;
+    ESP8266_SSID_FRAMEWORK_CREDENTIAL_RECORD credential;
+}ESP8266_SSID_FRAMEWORK_PARAM_RECORD;
+
+//CUSTOM FIELD TYPES AND THEIR PACKED SIZE
+//STRING : max_len + 1 BYTES (NUL TERMINATED)
+//INT    : 4 BYTES (int32_t)
+//BOOL   : 1 BYTE
+//IPV4   : 4 BYTES (ip_addr_t)
+//ENUM   : 1 BYTE (OPTION INDEX)
+typedef enum
+{
+    ESP8266_SSID_FRAMEWORK_FIELD_STRING = 0,
+    ESP8266_SSID_FRAMEWORK_FIELD_INT,
+    ESP8266_SSID_FRAMEWORK_FIELD_BOOL,
+    ESP8266_SSID_FRAMEWORK_FIELD_IPV4,
+    ESP8266_SSID_FRAMEWORK_FIELD_ENUM
+}ESP8266_SSID_FRAMEWORK_FIELD_TYPE;
+
+//FIELDS DECLARED WITH ONLY NAME AND LABEL ARE STRING FIELDS OF MAX LENGTH
+//(CUSTOM_FIELD_VALUE_LEN - 1). INT RANGE IS ONLY CHECKED IF min != max
 typedef struct
 {
     char* custom_field_name;
     char* custom_field_label;
+    ESP8266_SSID_FRAMEWORK_FIELD_TYPE custom_field_type;
+    uint8_t custom_field_max_len;
+    int32_t custom_field_min;
+    int32_t custom_field_max;
+    char** custom_field_options;
+    uint8_t custom_field_options_count;
 } ESP8266_SSID_FRAMEWORK_CONFIG_USER_FIELD;
 
 typedef struct
@@ -147,11 +571,55 @@ void ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_SetParameters(ESP8266_SSID_FRAMEWO
                                                             uint8_t gpio_led_pin,
 															char* project_name);
 
+#if ESP8266_SSID_FRAMEWORK_MODULE_INPUT_GPIO
 void ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_SetGpioTriggerLevelSet(ESP8266_SSID_FRAMEWORK_GPIO_TRIGGER level);
+#endif
 void ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_SetCbFunctions(void (*wifi_connected_cb)(char**));
+void ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_SetLinkCbFunctions(void (*link_up_cb)(void), void (*link_down_cb)(uint8_t));
+uint8_t ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_Subscribe(uint32_t mask, void (*listener)(ESP8266_SSID_FRAMEWORK_EVENT*, void*), void* arg);
+void ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_Unsubscribe(void (*listener)(ESP8266_SSID_FRAMEWORK_EVENT*, void*), void* arg);
+void ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_SetSupervisorParameters(uint32_t probe_interval_ms, uint32_t outage_budget_ms);
+#if ESP8266_SSID_FRAMEWORK_MODULE_ROAMING
+void ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_SetRoaming(uint8_t enable, int8_t rssi_threshold);
+#endif
+#if ESP8266_SSID_FRAMEWORK_MODULE_OTA
+void ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_SetOtaKey(char* key);
+#endif
+void ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_SetIpMode(ESP8266_SSID_FRAMEWORK_IP_MODE mode, struct ip_info* static_ip, ip_addr_t* static_dns);
 
 //OPERATION FUNCTIONS
 void ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_Initialize(void);
+ESP8266_SSID_FRAMEWORK_STATE ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_GetState(void);
+#if ESP8266_SSID_FRAMEWORK_MODULE_ROAMING
+int8_t ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_GetAverageRssi(void);
+#endif
+uint16_t ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_GetDisconnectCount(uint8_t reason);
+void ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_ResetDisconnectCounts(void);
+ESP8266_SSID_FRAMEWORK_IP_MODE ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_GetIpMode(void);
+uint32_t ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_GetTimeToIp(ESP8266_SSID_FRAMEWORK_IP_MODE mode);
+char* ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_GetHostname(void);
+void ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_GetEventStats(ESP8266_SSID_FRAMEWORK_EVENT_STATS* stats);
+char* ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_GetFieldString(uint8_t index);
+uint8_t ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_GetFieldInt(uint8_t index, int32_t* value);
+uint8_t ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_GetFieldBool(uint8_t index, uint8_t* value);
+uint8_t ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_GetFieldIp(uint8_t index, ip_addr_t* value);
+uint8_t ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_GetFieldEnum(uint8_t index, uint8_t* value);
+#if ESP8266_SSID_FRAMEWORK_MODULE_OTA
+void ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_GetOtaStats(ESP8266_SSID_FRAMEWORK_OTA_STATS* stats);
+#endif
+#if ESP8266_SSID_FRAMEWORK_MODULE_STATS
+void ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_GetStats(ESP8266_SSID_FRAMEWORK_STATS* stats);
+void ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_ResetStats(void);
+#endif
+#if ESP8266_SSID_FRAMEWORK_MODULE_CREDENTIAL_CRYPT
+uint32_t ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_GetCredentialDecryptTime(void);
+#endif
+#if ESP8266_SSID_FRAMEWORK_MODULE_CONFIG_WEBCONFIG
+void ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_GetArenaStats(ESP8266_SSID_FRAMEWORK_ARENA_STATS* stats);
+#endif
+#if ESP8266_SSID_FRAMEWORK_MODULE_PORTAL_BENCH
+uint8_t ICACHE_FLASH_ATTR ESP8266_SSID_FRAMEWORK_RunPortalBenchmark(uint8_t field_count, uint8_t iterations, ESP8266_SSID_FRAMEWORK_BENCH_RESULT* result);
+#endif
 
 //INTERNAL FUNCTIONS
 void ICACHE_FLASH_ATTR _esp8266_ssid_framework_led_toggle_cb(void* pArg);
@@ -159,8 +627,89 @@ void ICACHE_FLASH_ATTR _esp8266_ssid_framework_wifi_connect_timer_cb(void* pArg)
 void ICACHE_FLASH_ATTR _esp8266_ssid_framework_wifi_event_handler_cb(System_Event_t* event);
 void ICACHE_FLASH_ATTR _esp8266_ssid_framework_wifi_start_ssid_configuration(void);
 void ICACHE_FLASH_ATTR _esp8266_ssid_framework_wifi_start_connection_process(struct station_config* sconfig);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_wifi_connect_candidate(void);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_wifi_on_connected(void);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_wifi_got_ip(void);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_ip_apply(uint8_t mode, struct ip_info* static_ip, ip_addr_t* static_dns, uint8_t* ssid);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_ip_lease_verify_start(void);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_ip_lease_verify_timer_cb(void* pArg);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_param_load(void);
+uint8_t ICACHE_FLASH_ATTR _esp8266_ssid_framework_param_save(void);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_custom_fields_layout(void);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_custom_fields_publish(void);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_event_post(uint8_t type, uint8_t detail, uint8_t* mac, ip_addr_t* ip);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_event_schedule(void);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_event_deliver_timer_cb(void* pArg);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_event_task(os_event_t* event);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_event_dispatch_legacy(ESP8266_SSID_FRAMEWORK_EVENT* event);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_connected_user_cb_timer_cb(void* pArg);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_supervisor_start(void);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_supervisor_link_lost(uint8_t reason);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_supervisor_probe_timer_cb(void* pArg);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_supervisor_ping_recv_cb(void* arg, void* pdata);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_supervisor_reconnect_timer_cb(void* pArg);
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_CONFIG_WEBCONFIG
 void ICACHE_FLASH_ATTR _esp8266_ssid_framework_wifi_start_softap(void);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_softap_scan_done_cb(void* arg, STATUS status);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_webconfig_start(void);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_webconfig_retry_timer_cb(void* pArg);
+uint8_t ICACHE_FLASH_ATTR _esp8266_ssid_framework_arena_reserve(void);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_arena_release(void);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_generate_config_page(void);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_credential_check_start(void);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_credential_check_scan_done_cb(void* arg, STATUS status);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_credential_check_timer_cb(void* pArg);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_credential_retry_timer_cb(void* pArg);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_credential_check_finish(uint8_t success, char* message);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_portal_teardown_timer_cb(void* pArg);
 void ICACHE_FLASH_ATTR _esp8266_ssid_framework_tcp_server_path_config_cb(void);
 void ICACHE_FLASH_ATTR _esp8266_ssid_framework_tcp_server_post_data_cb(char* data, uint16_t len, uint8_t post_flag);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_post_reassemble(char* data, uint16_t len);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_form_post(char* data);
+#endif
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_PORTAL_BENCH
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_bench_request(char* request);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_bench_measure(ESP8266_SSID_FRAMEWORK_BENCH_KIND kind, char* request, uint8_t iterations, ESP8266_SSID_FRAMEWORK_BENCH_STATS* stats);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_bench_sample_memory(void);
+#endif
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_OTA
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_ota_begin(char* data, uint16_t len);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_ota_write(uint8_t* data, uint16_t len);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_ota_flush(void);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_ota_fail(char* message);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_ota_end(void);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_ota_idle_timer_cb(void* pArg);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_ota_reboot_timer_cb(void* pArg);
+#endif
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_CREDENTIAL_CRYPT
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_credential_keys(void);
+uint8_t ICACHE_FLASH_ATTR _esp8266_ssid_framework_credential_store(struct station_config* config);
+uint8_t ICACHE_FLASH_ATTR _esp8266_ssid_framework_credential_load(struct station_config* config);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_credential_migrate(void);
+#endif
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_STATS
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_stats_load(void);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_stats_changed(void);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_stats_flush_timer_cb(void* pArg);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_stats_count_time_to_ip(uint32_t time_ms);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_stats_sample_rssi(void);
+#endif
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_STATION_MDNS
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_mdns_start(void);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_mdns_stop(void);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_mdns_announce_timer_cb(void* pArg);
+#endif
+
+#if ESP8266_SSID_FRAMEWORK_MODULE_ROAMING
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_roam_start(void);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_roam_sample_timer_cb(void* pArg);
+void ICACHE_FLASH_ATTR _esp8266_ssid_framework_roam_scan_done_cb(void* arg, STATUS status);
+#endif
 
 #endif
@@ -0,0 +1,75 @@
+/*************************************************************
+* HOST BUILD : CREDENTIAL DECRYPT BENCHMARK
+*
+* LINKS ESP8266_SSID_FRAMEWORK.c (CREDENTIAL CRYPT MODULE ON) AGAINST
+* THE SDK STUBS, STORES ONE ENCRYPTED CREDENTIAL RECORD AND TIMES
+* _esp8266_ssid_framework_credential_load (SIPHASH MAC CHECK + CHACHA20
+* DECRYPT OF SSID AND PASSWORD), THE WORK DONE ON EVERY BOOT BEFORE
+* CONNECTING. THE FIRST STORE ALSO DERIVES THE KEYS AND IS SHOWN APART
+*
+* HOST NUMBERS ARE FOR COMPARING CHANGES TO THE CIPHER CODE ONLY,
+* ABSOLUTE LATENCIES DO NOT CARRY OVER TO THE DEVICE.
+* BUILD AND RUN WITH host/credential_bench.sh
+*************************************************************/
+
+#include <stdio.h>
+#include "ESP8266_SSID_FRAMEWORK.h"
+
+#define BENCH_ROUNDS        15
+#define BENCH_LOADS         2000
+
+int main(void)
+{
+    struct station_config config;
+    struct station_config loaded;
+    uint32_t round_us[BENCH_ROUNDS];
+    uint32_t start_us;
+    uint32_t temp;
+    uint16_t i;
+    uint16_t j;
+
+    os_memset(&config, 0, sizeof(struct station_config));
+    os_strcpy((char*)config.ssid, "BenchNet-5G-Upstairs");
+    os_strcpy((char*)config.password, "correct horse battery staple");
+
+    //ENCRYPT INTO THE (IN MEMORY) PARAMETER RECORD. KEYS ARE DERIVED HERE
+    start_us = system_get_time();
+    _esp8266_ssid_framework_credential_store(&config);
+    printf("CREDENTIAL DECRYPT BENCHMARK (HOST), %u ROUNDS OF %u LOADS\n\n", BENCH_ROUNDS, BENCH_LOADS);
+    printf("first store (key derivation + encrypt) : %u us\n", system_get_time() - start_us);
+
+    if(!_esp8266_ssid_framework_credential_load(&loaded) ||
+        os_strcmp((char*)loaded.ssid, (char*)config.ssid) != 0 ||
+        os_strcmp((char*)loaded.password, (char*)config.password) != 0)
+    {
+        printf("stored credentials do not decrypt\n");
+        return 1;
+    }
+
+    for(i = 0; i < BENCH_ROUNDS; i++)
+    {
+        start_us = system_get_time();
+        for(j = 0; j < BENCH_LOADS; j++)
+        {
+            _esp8266_ssid_framework_credential_load(&loaded);
+        }
+        round_us[i] = system_get_time() - start_us;
+    }
+
+    //SORT THE ROUNDS FOR THE MEDIAN
+    for(i = 1; i < BENCH_ROUNDS; i++)
+    {
+        temp = round_us[i];
+        for(j = i; j > 0 && round_us[j - 1] > temp; j--)
+        {
+            round_us[j] = round_us[j - 1];
+        }
+        round_us[j] = temp;
+    }
+
+    printf("decrypt per record : min %.3f us, median %.3f us, max %.3f us\n",
+            (double)round_us[0] / BENCH_LOADS,
+            (double)round_us[BENCH_ROUNDS / 2] / BENCH_LOADS,
+            (double)round_us[BENCH_ROUNDS - 1] / BENCH_LOADS);
+    return 0;
+}
@@ -0,0 +1,28 @@
+#!/bin/sh
+#ESP8266 SSID FRAMEWORK : HOST CREDENTIAL DECRYPT BENCHMARK
+#
+#BUILDS ESP8266_SSID_FRAMEWORK.c WITH THE CREDENTIAL CRYPT MODULE AGAINST THE
+#SDK STUBS IN host/stubs, LINKS host/credential_bench.c AND RUNS IT.
+#THE BASELINE OUTPUT IS KEPT IN host/credential_bench.txt, COMPARE AGAINST IT
+#AFTER CHANGING THE CIPHER CODE
+#
+#USAGE : ./host/credential_bench.sh [extra cflags]
+#CC CAN BE OVERRIDDEN
+
+CC=${CC:-gcc}
+
+HOST_DIR=$(cd "$(dirname "$0")" && pwd)
+SRC_DIR=$(dirname "$HOST_DIR")
+TMP_DIR=$(mktemp -d) || exit 1
+trap 'rm -rf "$TMP_DIR"' EXIT
+
+CFLAGS="-Os -std=gnu99 -Wall -I$HOST_DIR/stubs -I$SRC_DIR \
+        -DESP8266_SSID_FRAMEWORK_MODULE_CREDENTIAL_CRYPT=1 \
+        -DESP8266_SSID_FRAMEWORK_CREDENTIAL_SECRET=\"host-bench\" $*"
+
+$CC $CFLAGS -o "$TMP_DIR/credential_bench" \
+    "$SRC_DIR/ESP8266_SSID_FRAMEWORK.c" "$HOST_DIR/sdk_stubs.c" "$HOST_DIR/credential_bench.c" \
+    || { echo "credential_bench : build failed"; exit 1; }
+
+#FRAMEWORK PRINTS GO TO STDERR
+"$TMP_DIR/credential_bench" 2>/dev/null
@@ -0,0 +1,79 @@
+/*************************************************************
+* HOST BUILD : CONFIG PORTAL REQUEST BENCHMARK
+*
+* LINKS ESP8266_SSID_FRAMEWORK.c (PORTAL BENCH MODULE ON) AGAINST THE
+* SDK STUBS AND RUNS ESP8266_SSID_FRAMEWORK_RunPortalBenchmark FOR 0 TO
+* 5 CUSTOM FIELDS (ONE OF EACH TYPE). EVERY ITERATION GOES THROUGH THE
+* TCP SERVER PATH AND POST CALLBACKS THE PORTAL REGISTERS
+*
+* HOST NUMBERS ARE FOR COMPARING CHANGES TO THE REQUEST PATH ONLY,
+* ABSOLUTE LATENCIES DO NOT CARRY OVER TO THE DEVICE.
+* BUILD AND RUN WITH host/portal_bench.sh
+*************************************************************/
+
+#include <stdio.h>
+#include "ESP8266_SSID_FRAMEWORK.h"
+
+//ONE WARM UP RUN PER FIELD COUNT, THEN THE MEASURED ONE
+#define BENCH_ITERATIONS    ESP8266_SSID_FRAMEWORK_BENCH_MAX_ITERATIONS
+
+static char* _bench_level_options[] = {"low", "mid", "high"};
+
+static ESP8266_SSID_FRAMEWORK_CONFIG_USER_FIELD _bench_fields[] =
+{
+    {"name", "Device name"},
+    {"port", "Port", ESP8266_SSID_FRAMEWORK_FIELD_INT, 0, 1, 65535},
+    {"enable", "Enable", ESP8266_SSID_FRAMEWORK_FIELD_BOOL},
+    {"server", "Server", ESP8266_SSID_FRAMEWORK_FIELD_IPV4},
+    {"level", "Level", ESP8266_SSID_FRAMEWORK_FIELD_ENUM, 0, 0, 0, _bench_level_options, 3}
+};
+
+static ESP8266_SSID_FRAMEWORK_CONFIG_USER_FIELD_GROUP _bench_field_group = {_bench_fields, 5};
+
+static void print_stats(uint8_t field_count, const char* kind, ESP8266_SSID_FRAMEWORK_BENCH_STATS* stats)
+{
+    printf("%6u  %-10s %7u %7u %7u %7u %8u %7u %6u %6u\n", field_count, kind,
+            stats->p50_us, stats->p90_us, stats->p99_us, stats->max_us,
+            stats->bytes_copied, stats->allocations, stats->peak_heap, stats->peak_arena);
+}
+
+int main(void)
+{
+    ESP8266_SSID_FRAMEWORK_BENCH_RESULT result;
+    uint32_t heap_before = system_get_free_heap_size();
+    uint8_t field_count;
+
+    ESP8266_SSID_FRAMEWORK_SetDebug(0);
+    ESP8266_SSID_FRAMEWORK_SetParameters(ESP8266_SSID_FRAMEWORK_SSID_INPUT_INTERNAL,
+                                         ESP8266_SSID_FRAMEWORK_CONFIG_WEBCONFIG,
+                                         NULL,
+                                         &_bench_field_group,
+                                         3,
+                                         4000,
+                                         2,
+                                         "Bench");
+
+    printf("PORTAL REQUEST BENCHMARK (HOST), %u ITERATIONS PER KIND, LATENCY IN us\n\n", BENCH_ITERATIONS);
+    printf("%6s  %-10s %7s %7s %7s %7s %8s %7s %6s %6s\n", "FIELDS", "KIND", "P50", "P90", "P99", "MAX", "COPIED", "ALLOCS", "HEAP", "ARENA");
+
+    for(field_count = 0; field_count <= _bench_field_group.custom_fields_count; field_count++)
+    {
+        if(!ESP8266_SSID_FRAMEWORK_RunPortalBenchmark(field_count, BENCH_ITERATIONS, &result) ||
+            !ESP8266_SSID_FRAMEWORK_RunPortalBenchmark(field_count, BENCH_ITERATIONS, &result))
+        {
+            printf("benchmark refused at %u fields\n", field_count);
+            return 1;
+        }
+        print_stats(field_count, "GET", &result.get);
+        print_stats(field_count, "POST", &result.post);
+        print_stats(field_count, "POST FRAG", &result.post_fragmented);
+    }
+
+    //EVERY RUN HAS TO GIVE BACK WHAT IT TOOK
+    if(system_get_free_heap_size() != heap_before)
+    {
+        printf("\nheap leak : %u bytes\n", heap_before - system_get_free_heap_size());
+        return 1;
+    }
+    return 0;
+}
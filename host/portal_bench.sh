@@ -0,0 +1,27 @@
+#!/bin/sh
+#ESP8266 SSID FRAMEWORK : HOST PORTAL REQUEST BENCHMARK
+#
+#BUILDS ESP8266_SSID_FRAMEWORK.c WITH THE PORTAL BENCH MODULE AGAINST THE
+#SDK STUBS IN host/stubs, LINKS host/portal_bench.c AND RUNS IT.
+#THE BASELINE OUTPUT IS KEPT IN host/portal_bench.txt, COMPARE AGAINST IT
+#AFTER CHANGING THE REQUEST PATH
+#
+#USAGE : ./host/portal_bench.sh [extra cflags]
+#CC CAN BE OVERRIDDEN
+
+CC=${CC:-gcc}
+
+HOST_DIR=$(cd "$(dirname "$0")" && pwd)
+SRC_DIR=$(dirname "$HOST_DIR")
+TMP_DIR=$(mktemp -d) || exit 1
+trap 'rm -rf "$TMP_DIR"' EXIT
+
+CFLAGS="-Os -std=gnu99 -Wall -I$HOST_DIR/stubs -I$SRC_DIR \
+        -DESP8266_SSID_FRAMEWORK_MODULE_PORTAL_BENCH=1 $*"
+
+$CC $CFLAGS -o "$TMP_DIR/portal_bench" \
+    "$SRC_DIR/ESP8266_SSID_FRAMEWORK.c" "$HOST_DIR/sdk_stubs.c" "$HOST_DIR/portal_bench.c" \
+    || { echo "portal_bench : build failed"; exit 1; }
+
+#FRAMEWORK PRINTS GO TO STDERR
+"$TMP_DIR/portal_bench" 2>/dev/null
@@ -0,0 +1,193 @@
+/*************************************************************
+* HOST BUILD : SDK AND COMPANION LIBRARY STUBS
+*
+* MINIMAL HOST IMPLEMENTATIONS OF EVERYTHING ESP8266_SSID_FRAMEWORK.c
+* CALLS, SO IT CAN BE LINKED AND DRIVEN ON A DEVELOPMENT MACHINE
+* (SEE THE host/ BENCH SCRIPTS). RADIO, FLASH AND TIMERS DO NOTHING.
+* THE HEAP IS ACCOUNTED SO system_get_free_heap_size MOVES LIKE IT
+* DOES ON THE DEVICE
+*
+* NOT FOR FIRMWARE BUILDS
+*************************************************************/
+
+#include <stdarg.h>
+#include <stdlib.h>
+#include <time.h>
+#include "osapi.h"
+#include "user_interface.h"
+#include "espconn.h"
+#include "ping.h"
+#include "lwip/netif.h"
+#include "netif/etharp.h"
+#include "ESP8266_GPIO.h"
+#include "ESP8266_MDNS.h"
+#include "ESP8266_SYSINFO.h"
+#include "ESP8266_TCP_SERVER.h"
+
+//FREE HEAP OF A TYPICAL NONOS APPLICATION BEFORE THE FRAMEWORK STARTS
+#define HOST_HEAP_SIZE      45000
+//SDK FLASH MAP REPORTED TO THE FRAMEWORK (4 = 4MB, 512KB + 512KB IMAGES)
+#define HOST_FLASH_MAP      FLASH_SIZE_32M_MAP_512_512
+
+struct netif* netif_list;
+
+static uint32_t _host_heap_in_use;
+
+//HEAP///////////////////////////////////////////////////
+//EVERY BLOCK CARRIES ITS SIZE IN FRONT SO os_free CAN ACCOUNT FOR IT
+
+void* os_malloc(size_t len)
+{
+    size_t* block = (size_t*)malloc(sizeof(size_t) + len);
+
+    if(block == NULL || _host_heap_in_use + len > HOST_HEAP_SIZE)
+    {
+        free(block);
+        return NULL;
+    }
+    block[0] = len;
+    _host_heap_in_use += len;
+    return block + 1;
+}
+
+void* os_zalloc(size_t len)
+{
+    void* ptr = os_malloc(len);
+
+    if(ptr != NULL)
+    {
+        memset(ptr, 0, len);
+    }
+    return ptr;
+}
+
+void os_free(void* ptr)
+{
+    size_t* block = (size_t*)ptr;
+
+    if(block == NULL)
+    {
+        return;
+    }
+    block--;
+    _host_heap_in_use -= block[0];
+    free(block);
+}
+
+uint32 system_get_free_heap_size(void)
+{
+    return HOST_HEAP_SIZE - _host_heap_in_use;
+}
+
+//SYSTEM/////////////////////////////////////////////////
+
+int os_printf(const char* format, ...)
+{
+    //FRAMEWORK OUTPUT GOES TO STDERR, BENCHMARK RESULTS TO STDOUT
+    va_list args;
+    int len;
+
+    va_start(args, format);
+    len = vfprintf(stderr, format, args);
+    va_end(args);
+    return len;
+}
+
+uint32 system_get_time(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32)(now.tv_sec * 1000000ULL + now.tv_nsec / 1000);
+}
+
+void os_delay_us(uint32_t us) { (void)us; }
+void system_soft_wdt_feed(void) {}
+uint32 system_get_chip_id(void) { return 0x00C0FFEE; }
+void os_timer_setfn(os_timer_t* timer, void (*fn)(void*), void* arg) { (void)timer; (void)fn; (void)arg; }
+void os_timer_arm(os_timer_t* timer, uint32_t ms, bool repeat) { (void)timer; (void)ms; (void)repeat; }
+void os_timer_disarm(os_timer_t* timer) { (void)timer; }
+bool system_os_task(os_task_t task, uint8 prio, os_event_t* queue, uint8 len) { (void)task; (void)prio; (void)queue; (void)len; return 1; }
+bool system_os_post(uint8 prio, os_signal_t sig, os_param_t par) { (void)prio; (void)sig; (void)par; return 1; }
+bool system_rtc_mem_read(uint8 addr, void* data, uint16 len) { (void)addr; memset(data, 0, len); return 1; }
+bool system_rtc_mem_write(uint8 addr, const void* data, uint16 len) { (void)addr; (void)data; (void)len; return 1; }
+
+//NOTHING IS STORED. EVERY LOAD FALLS BACK TO THE DEFAULTS
+bool system_param_load(uint16 sector, uint16 offset, void* data, uint16 len) { (void)sector; (void)offset; (void)data; (void)len; return 0; }
+bool system_param_save_with_protect(uint16 sector, void* data, uint16 len) { (void)sector; (void)data; (void)len; return 1; }
+
+uint32_t ipaddr_addr(const char* cp)
+{
+    unsigned int a, b, c, d;
+    char extra;
+
+    if(sscanf(cp, "%u.%u.%u.%u%c", &a, &b, &c, &d, &extra) != 4 || a > 255 || b > 255 || c > 255 || d > 255)
+    {
+        return IPADDR_NONE;
+    }
+    return a | (b << 8) | (c << 16) | (d << 24);
+}
+
+//WIFI///////////////////////////////////////////////////
+
+void wifi_set_event_handler_cb(wifi_event_handler_cb_t cb) { (void)cb; }
+bool wifi_set_opmode(uint8 mode) { (void)mode; return 1; }
+bool wifi_set_opmode_current(uint8 mode) { (void)mode; return 1; }
+bool wifi_station_get_config(struct station_config* config) { memset(config, 0, sizeof(*config)); return 1; }
+bool wifi_station_get_config_default(struct station_config* config) { memset(config, 0, sizeof(*config)); return 1; }
+bool wifi_station_set_config(struct station_config* config) { (void)config; return 1; }
+bool wifi_station_set_config_current(struct station_config* config) { (void)config; return 1; }
+bool wifi_station_connect(void) { return 1; }
+bool wifi_station_disconnect(void) { return 1; }
+bool wifi_station_set_auto_connect(uint8 set) { (void)set; return 1; }
+bool wifi_station_set_reconnect_policy(bool set) { (void)set; return 1; }
+bool wifi_station_dhcpc_start(void) { return 1; }
+bool wifi_station_dhcpc_stop(void) { return 1; }
+bool wifi_station_scan(struct scan_config* config, scan_done_cb_t cb) { (void)config; (void)cb; return 0; }
+sint8 wifi_station_get_rssi(void) { return -60; }
+uint8 wifi_station_get_connect_status(void) { return STATION_IDLE; }
+uint8 wifi_get_channel(void) { return 1; }
+bool wifi_softap_get_config(struct softap_config* config) { memset(config, 0, sizeof(*config)); return 1; }
+bool wifi_softap_set_config_current(struct softap_config* config) { (void)config; return 1; }
+bool wifi_softap_dhcps_stop(void) { return 1; }
+bool wifi_get_ip_info(uint8 interface, struct ip_info* info) { (void)interface; memset(info, 0, sizeof(*info)); return 1; }
+bool wifi_set_ip_info(uint8 interface, struct ip_info* info) { (void)interface; (void)info; return 1; }
+
+//NETWORK////////////////////////////////////////////////
+
+void espconn_dns_setserver(char numdns, ip_addr_t* dnsserver) { (void)numdns; (void)dnsserver; }
+ip_addr_t espconn_dns_getserver(uint8 numdns) { ip_addr_t none = {0}; (void)numdns; return none; }
+void espconn_mdns_init(struct mdns_info* info) { (void)info; }
+void espconn_mdns_close(void) {}
+void espconn_mdns_server_register(void) {}
+void espconn_mdns_server_unregister(void) {}
+bool ping_start(struct ping_option* option) { (void)option; return 1; }
+bool ping_regist_recv(struct ping_option* option, ping_recv_function fn) { (void)option; (void)fn; return 1; }
+bool ping_regist_sent(struct ping_option* option, ping_sent_function fn) { (void)option; (void)fn; return 1; }
+signed char etharp_request(struct netif* netif, ip_addr_t* ipaddr) { (void)netif; (void)ipaddr; return 0; }
+signed char etharp_find_addr(struct netif* netif, ip_addr_t* ipaddr, struct eth_addr** eth_ret, ip_addr_t** ip_ret) { (void)netif; (void)ipaddr; (void)eth_ret; (void)ip_ret; return -1; }
+
+//COMPANION LIBRARIES////////////////////////////////////
+
+void ESP8266_GPIO_Set_Direction(uint8_t pin, uint8_t dir) { (void)pin; (void)dir; }
+uint8_t ESP8266_GPIO_Get_Value(uint8_t pin) { (void)pin; return 0; }
+void ESP8266_GPIO_Set_Value(uint8_t pin, uint8_t value) { (void)pin; (void)value; }
+
+void ESP8266_MDNS_SetDebug(uint8_t debug) { (void)debug; }
+void ESP8266_MDNS_Initialize(char* host, char* service, uint16_t port, uint8_t softap) { (void)host; (void)service; (void)port; (void)softap; }
+void ESP8266_MDNS_Stop(void) {}
+
+uint32_t ESP8266_SYSINFO_GetCpuFrequency(void) { return 80; }
+void ESP8266_SYSINFO_GetSystemMac(uint8_t* mac) { memcpy(mac, "\x5C\xCF\x7F\x00\x00\x01", 6); }
+uint32_t ESP8266_SYSINFO_GetFlashChipId(void) { return 0x1640EF; }
+uint8_t ESP8266_SYSINFO_GetSystemFlashMap(void) { return HOST_FLASH_MAP; }
+uint8_t ESP8266_SYSINFO_GetFlashChipMode(void) { return 0; }
+const char* ESP8266_SYSINFO_GetSDKVersion(void) { return "host"; }
+
+void ESP8266_TCP_SERVER_SetDebug(uint8_t debug) { (void)debug; }
+void ESP8266_TCP_SERVER_Initialize(uint16_t port, uint16_t timeout, uint8_t max_conn) { (void)port; (void)timeout; (void)max_conn; }
+void ESP8266_TCP_SERVER_SetDataEndingString(char* ending) { (void)ending; }
+void ESP8266_TCP_SERVER_SetCallbackFunctions(void* a, void* b, void* c, void* d, void (*post_cb)(char*, uint16_t, uint8_t)) { (void)a; (void)b; (void)c; (void)d; (void)post_cb; }
+void ESP8266_TCP_SERVER_RegisterUrlPathCb(ESP8266_TCP_SERVER_PATH_CB_ENTRY entry) { (void)entry; }
+void ESP8266_TCP_SERVER_Start(void) {}
+void ESP8266_TCP_SERVER_Stop(void) {}
@@ -0,0 +1,6 @@
+//HOST BUILD STUB FOR ESP8266_MDNS.h
+//DECLARES ONLY WHAT ESP8266_SSID_FRAMEWORK.c USES, SO IT CAN BE COMPILED
+//ON A DEVELOPMENT MACHINE WITHOUT THE SDK. NOT FOR FIRMWARE BUILDS
+#pragma once
+#include <stdint.h>
+void ESP8266_MDNS_SetDebug(uint8_t); void ESP8266_MDNS_Initialize(char*, char*, uint16_t, uint8_t); void ESP8266_MDNS_Stop(void);
@@ -0,0 +1,6 @@
+//HOST BUILD STUB FOR ESP8266_SYSINFO.h
+//DECLARES ONLY WHAT ESP8266_SSID_FRAMEWORK.c USES, SO IT CAN BE COMPILED
+//ON A DEVELOPMENT MACHINE WITHOUT THE SDK. NOT FOR FIRMWARE BUILDS
+#pragma once
+#include <stdint.h>
+uint32_t ESP8266_SYSINFO_GetCpuFrequency(void); void ESP8266_SYSINFO_GetSystemMac(uint8_t*); uint32_t ESP8266_SYSINFO_GetFlashChipId(void); uint8_t ESP8266_SYSINFO_GetSystemFlashMap(void); uint8_t ESP8266_SYSINFO_GetFlashChipMode(void); const char* ESP8266_SYSINFO_GetSDKVersion(void);
@@ -0,0 +1,9 @@
+//HOST BUILD STUB FOR ESP8266_TCP_SERVER.h
+//DECLARES ONLY WHAT ESP8266_SSID_FRAMEWORK.c USES, SO IT CAN BE COMPILED
+//ON A DEVELOPMENT MACHINE WITHOUT THE SDK. NOT FOR FIRMWARE BUILDS
+#pragma once
+#include <stdint.h>
+typedef struct { const char* path_string; void (*path_cb_fn)(void); uint8_t path_found; char* path_response; } ESP8266_TCP_SERVER_PATH_CB_ENTRY;
+void ESP8266_TCP_SERVER_SetDebug(uint8_t); void ESP8266_TCP_SERVER_Initialize(uint16_t, uint16_t, uint8_t); void ESP8266_TCP_SERVER_SetDataEndingString(char*);
+void ESP8266_TCP_SERVER_SetCallbackFunctions(void*, void*, void*, void*, void (*)(char*, uint16_t, uint8_t));
+void ESP8266_TCP_SERVER_RegisterUrlPathCb(ESP8266_TCP_SERVER_PATH_CB_ENTRY); void ESP8266_TCP_SERVER_Start(void); void ESP8266_TCP_SERVER_Stop(void);
@@ -0,0 +1,9 @@
+//HOST BUILD STUB FOR espconn.h
+//DECLARES ONLY WHAT ESP8266_SSID_FRAMEWORK.c USES, SO IT CAN BE COMPILED
+//ON A DEVELOPMENT MACHINE WITHOUT THE SDK. NOT FOR FIRMWARE BUILDS
+#pragma once
+#include "lwip/ip_addr.h"
+void espconn_dns_setserver(char numdns, ip_addr_t* dnsserver);
+struct mdns_info { char* host_name; char* server_name; uint16 server_port; unsigned long ipAddr; char* txt_data[10]; };
+void espconn_mdns_init(struct mdns_info*); void espconn_mdns_close(void); void espconn_mdns_server_register(void); void espconn_mdns_server_unregister(void);
+ip_addr_t espconn_dns_getserver(uint8 numdns);
@@ -0,0 +1,18 @@
+//HOST BUILD STUB FOR ets_sys.h
+//DECLARES ONLY WHAT ESP8266_SSID_FRAMEWORK.c USES, SO IT CAN BE COMPILED
+//ON A DEVELOPMENT MACHINE WITHOUT THE SDK. NOT FOR FIRMWARE BUILDS
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+typedef uint8_t uint8; typedef int8_t sint8; typedef uint16_t uint16; typedef uint32_t uint32; typedef int32_t sint32; typedef int16_t sint16;
+typedef int STATUS; enum {OK=0, FAIL, PENDING, BUSY, CANCEL};
+#define ICACHE_FLASH_ATTR __attribute__((section(".irom0.text")))
+#define ICACHE_RODATA_ATTR __attribute__((section(".irom.text")))
+#define TRUE 1
+#define FALSE 0
+typedef uint32_t os_signal_t; typedef uint32_t os_param_t;
+typedef struct { os_signal_t sig; os_param_t par; } os_event_t;
+typedef void (*os_task_t)(os_event_t*);
+#define STAILQ_ENTRY(t) struct { struct t* stqe_next; }
+#define STAILQ_NEXT(e, f) ((e)->f.stqe_next)
@@ -0,0 +1,10 @@
+//HOST BUILD STUB FOR lwip/ip_addr.h
+//DECLARES ONLY WHAT ESP8266_SSID_FRAMEWORK.c USES, SO IT CAN BE COMPILED
+//ON A DEVELOPMENT MACHINE WITHOUT THE SDK. NOT FOR FIRMWARE BUILDS
+#pragma once
+#include <stdint.h>
+struct ip_addr { uint32_t addr; }; typedef struct ip_addr ip_addr_t;
+#define IP2STR(ipaddr) ((uint8_t*)(ipaddr))[0],((uint8_t*)(ipaddr))[1],((uint8_t*)(ipaddr))[2],((uint8_t*)(ipaddr))[3]
+#define IPSTR "%d.%d.%d.%d"
+uint32_t ipaddr_addr(const char*);
+#define IPADDR_NONE ((uint32_t)0xffffffffUL)
@@ -0,0 +1,7 @@
+//HOST BUILD STUB FOR lwip/netif.h
+//DECLARES ONLY WHAT ESP8266_SSID_FRAMEWORK.c USES, SO IT CAN BE COMPILED
+//ON A DEVELOPMENT MACHINE WITHOUT THE SDK. NOT FOR FIRMWARE BUILDS
+#pragma once
+#include "lwip/ip_addr.h"
+struct netif { struct netif* next; ip_addr_t ip_addr; ip_addr_t netmask; ip_addr_t gw; unsigned char hwaddr[6]; };
+extern struct netif* netif_list;
@@ -0,0 +1,8 @@
+//HOST BUILD STUB FOR netif/etharp.h
+//DECLARES ONLY WHAT ESP8266_SSID_FRAMEWORK.c USES, SO IT CAN BE COMPILED
+//ON A DEVELOPMENT MACHINE WITHOUT THE SDK. NOT FOR FIRMWARE BUILDS
+#pragma once
+#include "lwip/netif.h"
+struct eth_addr { unsigned char addr[6]; };
+signed char etharp_request(struct netif* netif, ip_addr_t* ipaddr);
+signed char etharp_find_addr(struct netif* netif, ip_addr_t* ipaddr, struct eth_addr** eth_ret, ip_addr_t** ip_ret);
@@ -0,0 +1,5 @@
+//HOST BUILD STUB FOR os_type.h
+//DECLARES ONLY WHAT ESP8266_SSID_FRAMEWORK.c USES, SO IT CAN BE COMPILED
+//ON A DEVELOPMENT MACHINE WITHOUT THE SDK. NOT FOR FIRMWARE BUILDS
+#pragma once
+typedef struct { int x; } os_timer_t;
@@ -0,0 +1,24 @@
+//HOST BUILD STUB FOR osapi.h
+//DECLARES ONLY WHAT ESP8266_SSID_FRAMEWORK.c USES, SO IT CAN BE COMPILED
+//ON A DEVELOPMENT MACHINE WITHOUT THE SDK. NOT FOR FIRMWARE BUILDS
+#pragma once
+#include <string.h>
+#include <stdio.h>
+#include "ets_sys.h"
+#include "os_type.h"
+int os_printf(const char*, ...);
+#define os_sprintf sprintf
+#define os_memset memset
+#define os_memcpy memcpy
+#define os_memmove memmove
+#define os_memcmp memcmp
+#define os_strlen strlen
+#define os_strcpy strcpy
+#define os_strncpy strncpy
+#define os_strcmp strcmp
+#define os_strncmp strncmp
+#define os_strstr strstr
+void* os_zalloc(size_t); void os_free(void*); void* os_malloc(size_t);
+void os_delay_us(uint32_t);
+void os_timer_setfn(os_timer_t*, void(*)(void*), void*); void os_timer_arm(os_timer_t*, uint32_t, bool); void os_timer_disarm(os_timer_t*);
+bool system_os_task(os_task_t, uint8, os_event_t*, uint8); bool system_os_post(uint8, os_signal_t, os_param_t);
@@ -0,0 +1,10 @@
+//HOST BUILD STUB FOR ping.h
+//DECLARES ONLY WHAT ESP8266_SSID_FRAMEWORK.c USES, SO IT CAN BE COMPILED
+//ON A DEVELOPMENT MACHINE WITHOUT THE SDK. NOT FOR FIRMWARE BUILDS
+#pragma once
+#include "ets_sys.h"
+typedef void (*ping_recv_function)(void* arg, void* pdata);
+typedef void (*ping_sent_function)(void* arg, void* pdata);
+struct ping_option { uint32 count; uint32 ip; uint32 coarse_time; ping_recv_function recv_function; ping_sent_function sent_function; void* reverse; };
+struct ping_resp { uint32 total_count; uint32 resp_time; uint32 seqno; uint32 timeout_count; uint32 bytes; uint32 total_bytes; uint32 total_time; sint8 ping_err; };
+bool ping_start(struct ping_option*); bool ping_regist_recv(struct ping_option*, ping_recv_function); bool ping_regist_sent(struct ping_option*, ping_sent_function);
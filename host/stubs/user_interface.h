@@ -0,0 +1,55 @@
+//HOST BUILD STUB FOR user_interface.h
+//DECLARES ONLY WHAT ESP8266_SSID_FRAMEWORK.c USES, SO IT CAN BE COMPILED
+//ON A DEVELOPMENT MACHINE WITHOUT THE SDK. NOT FOR FIRMWARE BUILDS
+#pragma once
+#include "ets_sys.h"
+#include "lwip/ip_addr.h"
+#define STATION_MODE 1
+#define SOFTAP_MODE 2
+#define STATIONAP_MODE 3
+#define STATION_IF 0
+#define SOFTAP_IF 1
+#define USER_TASK_PRIO_0 0
+#define USER_TASK_PRIO_1 1
+#define USER_TASK_PRIO_2 2
+typedef enum { AUTH_OPEN = 0, AUTH_WEP, AUTH_WPA_PSK, AUTH_WPA2_PSK, AUTH_WPA_WPA2_PSK, AUTH_MAX } AUTH_MODE;
+enum { STATION_IDLE=0, STATION_CONNECTING, STATION_WRONG_PASSWORD, STATION_NO_AP_FOUND, STATION_CONNECT_FAIL, STATION_GOT_IP };
+enum { FLASH_SIZE_4M_MAP_256_256 = 0, FLASH_SIZE_2M, FLASH_SIZE_8M_MAP_512_512, FLASH_SIZE_16M_MAP_512_512, FLASH_SIZE_32M_MAP_512_512, FLASH_SIZE_16M_MAP_1024_1024, FLASH_SIZE_32M_MAP_1024_1024 };
+struct station_config { uint8 ssid[32]; uint8 password[64]; uint8 bssid_set; uint8 bssid[6]; };
+struct softap_config { uint8 ssid[32]; uint8 password[64]; uint8 ssid_len; uint8 channel; AUTH_MODE authmode; uint8 ssid_hidden; uint8 max_connection; uint16 beacon_interval; };
+struct scan_config { uint8 *ssid; uint8 *bssid; uint8 channel; uint8 show_hidden; };
+struct bss_info { STAILQ_ENTRY(bss_info) next; uint8 bssid[6]; uint8 ssid[32]; uint8 ssid_len; uint8 channel; sint8 rssi; AUTH_MODE authmode; uint8 is_hidden; };
+typedef void (*scan_done_cb_t)(void *arg, STATUS status);
+struct ip_info { struct ip_addr ip; struct ip_addr netmask; struct ip_addr gw; };
+enum { REASON_UNSPECIFIED=1, REASON_AUTH_EXPIRE=2, REASON_AUTH_LEAVE=3, REASON_ASSOC_EXPIRE=4, REASON_ASSOC_TOOMANY=5, REASON_NOT_AUTHED=6, REASON_NOT_ASSOCED=7, REASON_ASSOC_LEAVE=8, REASON_ASSOC_NOT_AUTHED=9, REASON_DISASSOC_PWRCAP_BAD=10, REASON_DISASSOC_SUPCHAN_BAD=11, REASON_IE_INVALID=13, REASON_MIC_FAILURE=14, REASON_4WAY_HANDSHAKE_TIMEOUT=15, REASON_GROUP_KEY_UPDATE_TIMEOUT=16, REASON_IE_IN_4WAY_DIFFERS=17, REASON_GROUP_CIPHER_INVALID=18, REASON_PAIRWISE_CIPHER_INVALID=19, REASON_AKMP_INVALID=20, REASON_UNSUPP_RSN_IE_VERSION=21, REASON_INVALID_RSN_IE_CAP=22, REASON_802_1X_AUTH_FAILED=23, REASON_CIPHER_SUITE_REJECTED=24, REASON_BEACON_TIMEOUT=200, REASON_NO_AP_FOUND=201, REASON_AUTH_FAIL=202, REASON_ASSOC_FAIL=203, REASON_HANDSHAKE_TIMEOUT=204 };
+enum { EVENT_STAMODE_CONNECTED = 0, EVENT_STAMODE_DISCONNECTED, EVENT_STAMODE_AUTHMODE_CHANGE, EVENT_STAMODE_GOT_IP, EVENT_STAMODE_DHCP_TIMEOUT, EVENT_SOFTAPMODE_STACONNECTED, EVENT_SOFTAPMODE_STADISCONNECTED, EVENT_SOFTAPMODE_PROBEREQRECVED, EVENT_MAX };
+typedef struct { uint8 ssid[32]; uint8 ssid_len; uint8 bssid[6]; uint8 channel; } Event_StaMode_Connected_t;
+typedef struct { uint8 ssid[32]; uint8 ssid_len; uint8 bssid[6]; uint8 reason; } Event_StaMode_Disconnected_t;
+typedef struct { struct ip_addr ip; struct ip_addr mask; struct ip_addr gw; } Event_StaMode_Got_IP_t;
+typedef struct { uint8 mac[6]; uint8 aid; } Event_SoftAPMode_StaConnected_t;
+typedef union { Event_StaMode_Connected_t connected; Event_StaMode_Disconnected_t disconnected; Event_StaMode_Got_IP_t got_ip; Event_SoftAPMode_StaConnected_t sta_connected; } Event_Info_u;
+typedef struct _esp_event { uint32 event; Event_Info_u event_info; } System_Event_t;
+typedef void (*wifi_event_handler_cb_t)(System_Event_t *event);
+void wifi_set_event_handler_cb(wifi_event_handler_cb_t);
+bool wifi_set_opmode(uint8); bool wifi_set_opmode_current(uint8); uint8 wifi_get_opmode(void);
+bool wifi_station_get_config(struct station_config*); bool wifi_station_get_config_default(struct station_config*);
+bool wifi_station_set_config(struct station_config*); bool wifi_station_set_config_current(struct station_config*);
+bool wifi_station_connect(void); bool wifi_station_disconnect(void);
+bool wifi_station_set_auto_connect(uint8); bool wifi_station_set_reconnect_policy(bool);
+bool wifi_station_dhcpc_start(void); bool wifi_station_dhcpc_stop(void);
+bool wifi_station_scan(struct scan_config*, scan_done_cb_t);
+sint8 wifi_station_get_rssi(void); uint8 wifi_station_get_connect_status(void);
+uint8 wifi_get_channel(void);
+bool wifi_softap_get_config(struct softap_config*); bool wifi_softap_set_config_current(struct softap_config*); bool wifi_softap_dhcps_stop(void);
+bool wifi_get_ip_info(uint8, struct ip_info*); bool wifi_set_ip_info(uint8, struct ip_info*);
+bool wifi_get_macaddr(uint8, uint8*);
+uint32 system_get_time(void); uint32 system_get_chip_id(void); uint32 system_get_free_heap_size(void);
+bool system_rtc_mem_read(uint8, void*, uint16); bool system_rtc_mem_write(uint8, const void*, uint16);
+bool system_param_save_with_protect(uint16, void*, uint16); bool system_param_load(uint16, uint16, void*, uint16);
+uint8 system_upgrade_userbin_check(void); void system_upgrade_flag_set(uint8); void system_upgrade_reboot(void);
+struct rst_info { uint32 reason; }; struct rst_info* system_get_rst_info(void);
+enum { REASON_DEFAULT_RST = 0, REASON_WDT_RST, REASON_EXCEPTION_RST, REASON_SOFT_WDT_RST, REASON_SOFT_RESTART, REASON_DEEP_SLEEP_AWAKE, REASON_EXT_SYS_RST };
+typedef enum { SPI_FLASH_RESULT_OK, SPI_FLASH_RESULT_ERR, SPI_FLASH_RESULT_TIMEOUT } SpiFlashOpResult;
+SpiFlashOpResult spi_flash_erase_sector(uint16); SpiFlashOpResult spi_flash_write(uint32, uint32*, uint32); SpiFlashOpResult spi_flash_read(uint32, uint32*, uint32);
+#define SPI_FLASH_SEC_SIZE 4096
+void system_soft_wdt_feed(void);
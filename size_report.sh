@@ -0,0 +1,75 @@
+#!/bin/sh
+#ESP8266 SSID FRAMEWORK : MODULE SIZE REPORT
+#
+#BUILDS ESP8266_SSID_FRAMEWORK.c ONCE WITH THE DEFAULT MODULE SELECTION AND
+#ONCE PER MODULE WITH THAT MODULE TOGGLED, THEN PRINTS WHAT EACH MODULE COSTS
+#IN IRAM (.text/.literal), DRAM (.data/.rodata/.bss) AND FLASH (.irom0.text)
+#
+#USAGE : SDK_PATH=<nonos sdk> LIBS_PATH=<companion libraries> ./size_report.sh [extra cflags]
+#CC / SIZE CAN BE OVERRIDDEN FOR A DIFFERENT TOOLCHAIN PREFIX, ARCH_CFLAGS FOR
+#ITS TARGET FLAGS. HOST PROXY RUN (NO XTENSA TOOLCHAIN, SEE size_report.txt) :
+#CC=gcc SIZE=size ARCH_CFLAGS= SDK_PATH=host/stubs LIBS_PATH=host/stubs ./size_report.sh
+
+CC=${CC:-xtensa-lx106-elf-gcc}
+SIZE=${SIZE:-xtensa-lx106-elf-size}
+ARCH_CFLAGS=${ARCH_CFLAGS--mlongcalls -mtext-section-literals}
+SDK_PATH=${SDK_PATH:-../ESP8266_NONOS_SDK}
+LIBS_PATH=${LIBS_PATH:-..}
+
+SRC_DIR=$(cd "$(dirname "$0")" && pwd)
+TMP_DIR=$(mktemp -d) || exit 1
+trap 'rm -rf "$TMP_DIR"' EXIT
+
+CFLAGS="-Os -std=gnu99 $ARCH_CFLAGS -DICACHE_FLASH \
+        -I$SDK_PATH/include -I$LIBS_PATH -I$SRC_DIR $*"
+
+PREFIX=ESP8266_SSID_FRAMEWORK_MODULE_
+MODULES="INPUT_HARDCODED:1 INPUT_INTERNAL:1 INPUT_GPIO:1
+         CONFIG_SMARTCONFIG:0 CONFIG_WEBCONFIG:1 SYSTEM_PARAMS:1 ROAMING:1 STATION_MDNS:1 OTA:0 STATS:1 PORTAL_BENCH:0 CREDENTIAL_CRYPT:0"
+
+#COMPILE WITH THE GIVEN -D FLAGS, PRINT "IRAM DRAM FLASH" BYTES
+measure()
+{
+    $CC $CFLAGS "$@" -c "$SRC_DIR/ESP8266_SSID_FRAMEWORK.c" -o "$TMP_DIR/obj.o" || return 1
+    $SIZE -A "$TMP_DIR/obj.o" | awk '
+        $1 ~ /^\.irom0/                         { flash += $2; next }
+        $1 ~ /^\.(text|literal)/                { iram += $2; next }
+        $1 ~ /^\.(data|rodata|bss)/             { dram += $2; next }
+        END                                     { printf "%d %d %d\n", iram, dram, flash }'
+}
+
+BASE=$(measure) || { echo "size_report : default build failed"; exit 1; }
+set -- $BASE
+BASE_IRAM=$1; BASE_DRAM=$2; BASE_FLASH=$3
+
+echo "DEFAULT BUILD : IRAM $BASE_IRAM  DRAM $BASE_DRAM  FLASH $BASE_FLASH (bytes)"
+echo
+echo "MODULE COST (BYTES ADDED WHEN THE MODULE IS COMPILED IN)"
+printf "%-20s %8s %8s %8s %8s\n" "MODULE" "DEFAULT" "IRAM" "DRAM" "FLASH"
+
+for entry in $MODULES; do
+    name=${entry%%:*}
+    default=${entry##*:}
+    toggled=$((1 - default))
+
+    #SYSTEM PARAMS, OTA AND THE PORTAL BENCHMARK GO WITH WEBCONFIG
+    extra=""
+    if [ "$name" = "CONFIG_WEBCONFIG" ] && [ "$toggled" = "0" ]; then
+        extra="-D${PREFIX}SYSTEM_PARAMS=0 -D${PREFIX}OTA=0 -D${PREFIX}PORTAL_BENCH=0"
+    fi
+    #CREDENTIAL ENCRYPTION NEEDS A BUILD SECRET
+    if [ "$name" = "CREDENTIAL_CRYPT" ] && [ "$toggled" = "1" ]; then
+        extra="-DESP8266_SSID_FRAMEWORK_CREDENTIAL_SECRET=\"size_report\""
+    fi
+
+    result=$(measure -D$PREFIX$name=$toggled $extra) || { printf "%-20s build failed\n" "$name"; continue; }
+    set -- $result
+
+    #COST = WITH MODULE - WITHOUT MODULE
+    if [ "$default" = "1" ]; then
+        iram=$((BASE_IRAM - $1)); dram=$((BASE_DRAM - $2)); flash=$((BASE_FLASH - $3))
+    else
+        iram=$(($1 - BASE_IRAM)); dram=$(($2 - BASE_DRAM)); flash=$(($3 - BASE_FLASH))
+    fi
+    printf "%-20s %8s %8d %8d %8d\n" "$name" "$default" "$iram" "$dram" "$flash"
+done